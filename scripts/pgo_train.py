@@ -0,0 +1,75 @@
+from __future__ import print_function
+from array import array
+from datetime import datetime
+from time import time
+import udatetime
+
+# Training corpus for the profile guided build (make pgo). Mix of inputs
+# seen in production: offsets, Zulu, varying fractions, spaces and a share
+# of invalid strings.
+RFC3339_STRINGS = [
+    '2016-07-18T12:58:26.485897+02:00',
+    '2016-07-18T12:58:26.485897Z',
+    '2016-07-18T12:58:26.485Z',
+    '2016-07-18T12:58:26Z',
+    '2016-07-18T12:58:26-05:30',
+    '2016-07-18t12:58:26.4+00:00',
+    '2016-07-18T12:58:26',
+    '2016-02-29T23:59:59.999999+14:00',
+    '2016-07-18 T 12:58:26.485897 +02:00',
+]
+INVALID_STRINGS = [
+    '2016-02-30T12:58:26Z',
+    '2016-07-18T24:58:26Z',
+    '2016-07-18T12:58:26.1Z0',
+    '2016-07-18 12:58:26Z',
+    'Hello World',
+]
+ITERATIONS = 20000
+
+
+def train():
+    strings = RFC3339_STRINGS * 4 + INVALID_STRINGS
+    datetimes = [udatetime.from_string(s) for s in RFC3339_STRINGS]
+    datetimes.append(datetime(2016, 7, 18, 12, 58, 26, 485897))
+    timestamps = array('q', [
+        udatetime.string_to_timestamp_us(s) for s in RFC3339_STRINGS
+    ] * 100)
+    out = array('q', timestamps)
+    t = time()
+
+    for _ in range(ITERATIONS):
+        for s in strings:
+            try:
+                udatetime.from_string(s)
+            except ValueError:
+                pass
+
+        for dt in datetimes:
+            udatetime.to_string(dt)
+
+        udatetime.utcnow()
+        udatetime.now()
+        udatetime.utcnow_to_string()
+        udatetime.now_to_string()
+        udatetime.fromtimestamp(t)
+        udatetime.utcfromtimestamp(t)
+        udatetime.utcnow_to_http_date()
+        udatetime.from_http_date(udatetime.to_http_date(t))
+
+    for _ in range(ITERATIONS // 100):
+        udatetime.validate_many(strings)
+        udatetime.normalize_many(RFC3339_STRINGS)
+        udatetime.to_bytes_many(datetimes)
+        udatetime.timestamps_to_strings(timestamps)
+        udatetime.floor_timestamps_us(timestamps, out, 'hour')
+        udatetime.floor_timestamps_us(timestamps, out, 'month')
+
+        for s in RFC3339_STRINGS:
+            udatetime.string_to_timestamp_us(s)
+            udatetime.from_string_tuple(s)
+
+
+if __name__ == '__main__':
+    print('Executing PGO training workload ...')
+    train()
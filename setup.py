@@ -29,6 +29,35 @@ elif sys.version_info.major == 2:
 elif sys.version_info.major == 3:
     macros.append(('_PYTHON3', '1'))
 
+# Hot path counters exposed by udatetime.stats()
+if os.environ.get('UDATETIME_STATS'):
+    macros.append(('UDATETIME_STATS', '1'))
+
+extra_compile_args = ['-Ofast', '-std=c99']
+extra_link_args = []
+
+# Profile guided optimization, see `make pgo`
+# UDATETIME_PGO=generate: instrumented build writing profiles to
+#                         UDATETIME_PGO_DIR when the module is used
+# UDATETIME_PGO=use:      optimized build using the profiles
+pgo = os.environ.get('UDATETIME_PGO')
+pgo_dir = os.environ.get('UDATETIME_PGO_DIR', '%s/build/pgo' % here)
+
+if pgo == 'generate':
+    extra_compile_args.append('-fprofile-generate=%s' % pgo_dir)
+    extra_link_args.append('-fprofile-generate=%s' % pgo_dir)
+elif pgo == 'use':
+    extra_compile_args.append('-fprofile-use=%s' % pgo_dir)
+elif pgo:
+    raise ValueError('UDATETIME_PGO must be "generate" or "use".')
+
+# CPU tuned build, e.g. UDATETIME_MARCH=native. The resulting binary might
+# not run on other CPUs.
+march = os.environ.get('UDATETIME_MARCH')
+
+if march:
+    extra_compile_args.append('-march=%s' % march)
+
 ext_modules = []
 
 if __pypy__ is None:
@@ -36,9 +65,10 @@ if __pypy__ is None:
         Extension(
             'udatetime.rfc3339',
             ['./src/rfc3339.c'],
-            libraries=['m'],
+            libraries=['m', 'pthread'],
             define_macros=macros,
-            extra_compile_args=['-Ofast', '-std=c99']
+            extra_compile_args=extra_compile_args,
+            extra_link_args=extra_link_args
         )
     )
 
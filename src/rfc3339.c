@@ -4,12 +4,16 @@
 #include <Python.h>
 #include <datetime.h>
 #include <structmember.h>
+#include <structseq.h>
 #endif
 
+#include <limits.h>
 #include <math.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <time.h>
 
 #ifdef HAVE_FTIME
@@ -21,6 +25,24 @@
 #define HOUR_IN_SECS 3600
 #define MINUTE_IN_SECS 60
 #define HOUR_IN_MINS 60
+#define SEC_IN_USECS 1000000LL
+#define PACKED_DATE_TIME_SIZE 10
+#define DATE_TIME_STRING_SIZE 32
+#define HTTP_DATE_SIZE 29
+
+// 0001-01-01T00:00:00Z - 1 day up to 9999-12-31T23:59:59Z + 1 day, any
+// offset applied within these bounds stays clear of int64 overflow
+#define MIN_TIMESTAMP_US (-62135683200LL * SEC_IN_USECS)
+#define MAX_TIMESTAMP_US (253402387199LL * SEC_IN_USECS)
+
+// Bucket units for _floor_timestamp_us
+#define UNIT_SECOND 0
+#define UNIT_MINUTE 1
+#define UNIT_HOUR 2
+#define UNIT_DAY 3
+#define UNIT_WEEK 4
+#define UNIT_MONTH 5
+#define UNIT_YEAR 6
 
 typedef struct {
     unsigned int year;
@@ -114,6 +136,53 @@ static double _gettime(void) {
     return 0.0;
 }
 
+/*
+ * Days since 1970-01-01 of the proleptic Gregorian date y-m-d
+ * (Howard Hinnant's days_from_civil), integer arithmetic only
+ */
+static long long _days_from_civil(int year, unsigned int month,
+                                  unsigned int day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned int yoe = (unsigned int)(year - era * 400);
+    const unsigned int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2)\
+        / 5 + day - 1;
+    const unsigned int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return (long long)era * 146097 + (long long)doe - 719468;
+}
+
+/*
+ * Proleptic Gregorian date of the given days since 1970-01-01
+ * (Howard Hinnant's civil_from_days), inverse of _days_from_civil
+ */
+static void _civil_from_days(long long days, int *year, unsigned int *month,
+                             unsigned int *day) {
+    days += 719468;
+    const long long era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned int doe = (unsigned int)(days - era * 146097);
+    const unsigned int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096)\
+        / 365;
+    const unsigned int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned int mp = (5 * doy + 2) / 153;
+
+    *day = doy - (153 * mp + 2) / 5 + 1;
+    *month = mp < 10 ? mp + 3 : mp - 9;
+    *year = (int)((long long)yoe + era * 400 + (*month <= 2));
+}
+
+/*
+ * Integer division rounding towards negative infinity, divisor > 0
+ */
+static long long _floor_div(long long a, long long b) {
+    long long q = a / b;
+
+    if ((a % b) != 0 && a < 0)
+        q -= 1;
+
+    return q;
+}
+
 /*
  * Parse a RFC3339 full-date
  * full-date = date-fullyear "-" date-month "-" date-mday
@@ -206,6 +275,10 @@ static void _parse_date(char *date_string, date_struct *d) {
             break;
     }
 
+    // 1970-01-01 was a Thursday, wday is tm_wday + 1 (Sunday = 1)
+    long long days = _days_from_civil((*d).year, (*d).month, (*d).day);
+    (*d).wday = (unsigned int)(((days % 7) + 11) % 7) + 1;
+
     (*d).ok = 1;
 }
 
@@ -404,6 +477,60 @@ static void _timestamp_to_date_time(double timestamp, date_time_struct *now,
     (*now).ok = 1;
 }
 
+/*
+ * Convert date_time_struct to microseconds since epoch (UTC), honoring
+ * time.offset. Does not call timegm()/mktime().
+ */
+static long long _date_time_to_timestamp_us(date_time_struct *dt) {
+    long long secs = _days_from_civil(
+        (*dt).date.year, (*dt).date.month, (*dt).date.day
+    ) * DAY_IN_SECS;
+
+    secs += (*dt).time.hour * HOUR_IN_SECS;
+    secs += (*dt).time.minute * MINUTE_IN_SECS;
+    secs += (*dt).time.second;
+    secs -= (*dt).time.offset * MINUTE_IN_SECS;
+
+    return secs * 1000000 + (*dt).time.fraction;
+}
+
+/*
+ * Signed microseconds between two date-times (a - b), each side's
+ * time.offset applied, integer civil arithmetic only
+ */
+static long long _date_time_diff_us(date_time_struct *a,
+                                    date_time_struct *b) {
+    return _date_time_to_timestamp_us(a) - _date_time_to_timestamp_us(b);
+}
+
+/*
+ * Convert microseconds since epoch to date_time_struct in the given UTC
+ * offset (minutes), integer civil arithmetic only
+ */
+static void _timestamp_us_to_date_time(long long timestamp_us,
+                                       date_time_struct *dt, int offset) {
+    long long local_us = timestamp_us +\
+        (long long)offset * MINUTE_IN_SECS * SEC_IN_USECS;
+    long long days = _floor_div(local_us, DAY_IN_SECS * SEC_IN_USECS);
+    long long day_us = local_us - days * DAY_IN_SECS * SEC_IN_USECS;
+    unsigned int secs = (unsigned int)(day_us / SEC_IN_USECS);
+    int year;
+
+    _civil_from_days(days, &year, &((*dt).date.month), &((*dt).date.day));
+    (*dt).date.year = (unsigned int)year;
+    (*dt).date.wday = (unsigned int)(((days % 7) + 11) % 7) + 1;
+    (*dt).date.ok = 1;
+
+    (*dt).time.hour = secs / HOUR_IN_SECS;
+    (*dt).time.minute = (secs % HOUR_IN_SECS) / MINUTE_IN_SECS;
+    (*dt).time.second = secs % MINUTE_IN_SECS;
+    (*dt).time.fraction = (unsigned int)(day_us % SEC_IN_USECS);
+    (*dt).time.offset = offset;
+    (*dt).time.ok = 1;
+
+    (*dt).ok = 1;
+}
+
 /*
  * Convert positive and negative timestamp double to date_time_struct
  * based on localtime
@@ -475,22 +602,528 @@ static void _format_date_time(date_time_struct *dt, char* datetime_string) {
         sign = '-';
     }
 
+    // fields are bounded to their widths, the output always fits 32 chars
     sprintf(
         datetime_string,
-        "%04d-%02d-%02dT%02d:%02d:%02d.%06d%c%02d:%02d",
-        (*dt).date.year,
-        (*dt).date.month,
-        (*dt).date.day,
-        (*dt).time.hour,
-        (*dt).time.minute,
-        (*dt).time.second,
-        (*dt).time.fraction,
+        "%04u-%02u-%02uT%02u:%02u:%02u.%06u%c%02u:%02u",
+        (*dt).date.year % 10000,
+        (*dt).date.month % 100,
+        (*dt).date.day % 100,
+        (*dt).time.hour % 100,
+        (*dt).time.minute % 100,
+        (*dt).time.second % 100,
+        (*dt).time.fraction % 1000000,
         sign,
-        offset / HOUR_IN_MINS,
-        offset % HOUR_IN_MINS
+        (unsigned int)offset / HOUR_IN_MINS % 100,
+        (unsigned int)offset % HOUR_IN_MINS
+    );
+}
+
+/*
+ * Create RFC3339 full-date string
+ */
+static void _format_date(date_struct *d, char *date_string) {
+    sprintf(
+        date_string,
+        "%04u-%02u-%02u",
+        (*d).year % 10000,
+        (*d).month % 100,
+        (*d).day % 100
+    );
+}
+
+/*
+ * Pack date-time into PACKED_DATE_TIME_SIZE bytes: little-endian int64
+ * microseconds since epoch (UTC) followed by little-endian int16 UTC
+ * offset in minutes
+ */
+static void _pack_date_time(date_time_struct *dt, unsigned char *packed) {
+    unsigned long long timestamp_us =\
+        (unsigned long long)_date_time_to_timestamp_us(dt);
+    unsigned int offset = (unsigned int)(*dt).time.offset;
+
+    for (int i = 0; i < 8; i++)
+        packed[i] = (unsigned char)(timestamp_us >> (i * 8));
+
+    packed[8] = (unsigned char)offset;
+    packed[9] = (unsigned char)(offset >> 8);
+}
+
+/*
+ * Unpack date-time packed by _pack_date_time. Out of range values are
+ * flagged invalid in dt.
+ */
+static void _unpack_date_time(const unsigned char *packed,
+                              date_time_struct *dt) {
+    unsigned long long timestamp_us = 0;
+
+    for (int i = 0; i < 8; i++)
+        timestamp_us |= (unsigned long long)packed[i] << (i * 8);
+
+    int offset = (short)(packed[8] | (packed[9] << 8));
+
+    (*dt).ok = 0;
+
+    // offset within +/-23:59
+    if (offset <= -24 * HOUR_IN_MINS || offset >= 24 * HOUR_IN_MINS) {
+        (*dt).date.ok = 1;
+        (*dt).time.ok = 0;
+        return;
+    }
+
+    if ((long long)timestamp_us < MIN_TIMESTAMP_US ||
+            (long long)timestamp_us > MAX_TIMESTAMP_US) {
+        (*dt).date.ok = 0;
+        return;
+    }
+
+    _timestamp_us_to_date_time((long long)timestamp_us, dt, offset);
+
+    if ((*dt).date.year < 1 || (*dt).date.year > 9999) {
+        (*dt).date.ok = 0;
+        (*dt).ok = 0;
+    }
+}
+
+/*
+ * Coarse clock: a ticker thread refreshes the current UTC and local
+ * date-time (struct and RFC3339 string) every resolution ns. Readers copy
+ * the snapshot under a seqlock instead of reading the clock and formatting.
+ */
+typedef struct {
+    unsigned int seq; // odd while the ticker is writing
+    date_time_struct utc;
+    date_time_struct local;
+    char utc_string[33];
+    char local_string[33];
+} coarse_clock_struct;
+
+static coarse_clock_struct coarse_clock;
+static int coarse_clock_running;
+static long long coarse_clock_resolution_ns;
+static pthread_t coarse_clock_thread;
+static pthread_mutex_t coarse_clock_lock = PTHREAD_MUTEX_INITIALIZER;
+// the ticker sleeps on coarse_clock_wakeup, signaled on stop
+static pthread_mutex_t coarse_clock_sleep_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t coarse_clock_wakeup;
+
+static void _coarse_clock_update(void) {
+    coarse_clock_struct snapshot;
+    long long now_us = (long long)floor(_gettime() * 1000000.0 + 0.5);
+
+    // gmtime() is not thread-safe, use the integer conversion
+    _timestamp_us_to_date_time(now_us, &(snapshot.utc), 0);
+    _timestamp_us_to_date_time(
+        now_us, &(snapshot.local), _get_local_utc_offset()
+    );
+    _format_date_time(&(snapshot.utc), snapshot.utc_string);
+    _format_date_time(&(snapshot.local), snapshot.local_string);
+
+    unsigned int seq = __atomic_load_n(&coarse_clock.seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&coarse_clock.seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    coarse_clock.utc = snapshot.utc;
+    coarse_clock.local = snapshot.local;
+    memcpy(coarse_clock.utc_string, snapshot.utc_string, 33);
+    memcpy(coarse_clock.local_string, snapshot.local_string, 33);
+
+    __atomic_store_n(&coarse_clock.seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+/*
+ * Condition variable on CLOCK_MONOTONIC, wall clock jumps must not
+ * stretch the ticker's sleep
+ */
+static void _coarse_clock_init_wakeup(void) {
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&coarse_clock_wakeup, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+static void *_coarse_clock_run(void *arg) {
+    pthread_mutex_lock(&coarse_clock_sleep_lock);
+
+    while (__atomic_load_n(&coarse_clock_running, __ATOMIC_ACQUIRE)) {
+        _coarse_clock_update();
+
+        long long ns = __atomic_load_n(
+            &coarse_clock_resolution_ns, __ATOMIC_RELAXED
+        );
+        struct timespec deadline;
+
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += (time_t)(ns / 1000000000LL);
+        deadline.tv_nsec += (long)(ns % 1000000000LL);
+
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        // running is only cleared with the sleep lock held, no lost wakeup
+        if (__atomic_load_n(&coarse_clock_running, __ATOMIC_ACQUIRE)) {
+            pthread_cond_timedwait(
+                &coarse_clock_wakeup, &coarse_clock_sleep_lock, &deadline
+            );
+        }
+    }
+
+    pthread_mutex_unlock(&coarse_clock_sleep_lock);
+    return NULL;
+}
+
+/*
+ * The ticker thread does not survive fork(), fall back to the precise clock.
+ * A fork during an update leaves seq odd, make it even again.
+ */
+static void _coarse_clock_atfork_child(void) {
+    __atomic_store_n(&coarse_clock_running, 0, __ATOMIC_RELAXED);
+    coarse_clock.seq = (coarse_clock.seq + 1) & ~1u;
+    pthread_mutex_init(&coarse_clock_lock, NULL);
+    pthread_mutex_init(&coarse_clock_sleep_lock, NULL);
+    _coarse_clock_init_wakeup();
+}
+
+/*
+ * Start the ticker thread or update its resolution if already running.
+ * Returns 0 on success.
+ */
+static int _coarse_clock_start(long long resolution_ns) {
+    static int atfork_registered = 0;
+    int status = 0;
+
+    pthread_mutex_lock(&coarse_clock_lock);
+    __atomic_store_n(
+        &coarse_clock_resolution_ns, resolution_ns, __ATOMIC_RELAXED
+    );
+
+    if (!__atomic_load_n(&coarse_clock_running, __ATOMIC_RELAXED)) {
+        if (!atfork_registered) {
+            _coarse_clock_init_wakeup();
+            pthread_atfork(NULL, NULL, _coarse_clock_atfork_child);
+            atfork_registered = 1;
+        }
+
+        // readers never see an empty snapshot
+        _coarse_clock_update();
+        __atomic_store_n(&coarse_clock_running, 1, __ATOMIC_RELEASE);
+
+        status = pthread_create(
+            &coarse_clock_thread, NULL, _coarse_clock_run, NULL
+        );
+
+        if (status != 0)
+            __atomic_store_n(&coarse_clock_running, 0, __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_unlock(&coarse_clock_lock);
+    return status;
+}
+
+/*
+ * Stop and join the ticker thread
+ */
+static void _coarse_clock_stop(void) {
+    pthread_mutex_lock(&coarse_clock_lock);
+
+    if (__atomic_load_n(&coarse_clock_running, __ATOMIC_RELAXED)) {
+        // wake the ticker instead of waiting out its resolution
+        pthread_mutex_lock(&coarse_clock_sleep_lock);
+        __atomic_store_n(&coarse_clock_running, 0, __ATOMIC_RELEASE);
+        pthread_cond_signal(&coarse_clock_wakeup);
+        pthread_mutex_unlock(&coarse_clock_sleep_lock);
+
+        pthread_join(coarse_clock_thread, NULL);
+    }
+
+    pthread_mutex_unlock(&coarse_clock_lock);
+}
+
+/*
+ * Copy the coarse clock snapshot, any argument may be NULL. Returns 0 if
+ * the coarse clock isn't running and nothing was copied.
+ */
+static int _coarse_clock_read(date_time_struct *utc, date_time_struct *local,
+                              char *utc_string, char *local_string) {
+    unsigned int seq;
+
+    if (!__atomic_load_n(&coarse_clock_running, __ATOMIC_RELAXED))
+        return 0;
+
+    do {
+        seq = __atomic_load_n(&coarse_clock.seq, __ATOMIC_ACQUIRE);
+        if (seq & 1)
+            continue;
+
+        if (utc) *utc = coarse_clock.utc;
+        if (local) *local = coarse_clock.local;
+        if (utc_string) memcpy(utc_string, coarse_clock.utc_string, 33);
+        if (local_string) memcpy(local_string, coarse_clock.local_string, 33);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1) ||
+             seq != __atomic_load_n(&coarse_clock.seq, __ATOMIC_RELAXED));
+
+    return 1;
+}
+
+/*
+ * Create canonical UTC RFC3339 date-time string, "Z" suffixed with
+ * precision (0 - 6) fraction digits. dt must be in UTC, time.offset is
+ * ignored.
+ */
+static void _format_date_time_utc(date_time_struct *dt, char *datetime_string,
+                                  unsigned int precision) {
+    int length = sprintf(
+        datetime_string,
+        "%04u-%02u-%02uT%02u:%02u:%02u",
+        (*dt).date.year % 10000,
+        (*dt).date.month % 100,
+        (*dt).date.day % 100,
+        (*dt).time.hour % 100,
+        (*dt).time.minute % 100,
+        (*dt).time.second % 100
+    );
+
+    if (precision > 0) {
+        unsigned int fraction = (*dt).time.fraction;
+
+        for (unsigned int i = precision; i < 6; i++)
+            fraction /= 10;
+
+        length += sprintf(
+            datetime_string + length, ".%0*u", (int)precision,
+            fraction % 1000000
+        );
+    }
+
+    datetime_string[length] = 'Z';
+    datetime_string[length + 1] = 0;
+}
+
+/*
+ * Floor microseconds since epoch to the start of its calendar bucket
+ * (UNIT_*) in a fixed UTC offset (minutes). Weeks are ISO weeks, starting
+ * on Monday. Returns the bucket start as microseconds since epoch.
+ */
+static long long _floor_timestamp_us(long long timestamp_us, int unit,
+                                     int offset) {
+    long long offset_us = (long long)offset * MINUTE_IN_SECS * SEC_IN_USECS;
+    long long local_us = timestamp_us + offset_us;
+    long long days;
+    int year;
+    unsigned int month, day;
+
+    switch(unit) {
+        case UNIT_SECOND:
+            local_us = _floor_div(local_us, SEC_IN_USECS) * SEC_IN_USECS;
+            break;
+        case UNIT_MINUTE:
+            local_us = _floor_div(local_us, MINUTE_IN_SECS * SEC_IN_USECS)\
+                * MINUTE_IN_SECS * SEC_IN_USECS;
+            break;
+        case UNIT_HOUR:
+            local_us = _floor_div(local_us, HOUR_IN_SECS * SEC_IN_USECS)\
+                * HOUR_IN_SECS * SEC_IN_USECS;
+            break;
+        case UNIT_DAY:
+            local_us = _floor_div(local_us, DAY_IN_SECS * SEC_IN_USECS)\
+                * DAY_IN_SECS * SEC_IN_USECS;
+            break;
+        case UNIT_WEEK:
+            // 1970-01-01 was a Thursday, 3 days after Monday
+            days = _floor_div(local_us, DAY_IN_SECS * SEC_IN_USECS);
+            days -= (days + 3) - _floor_div(days + 3, 7) * 7;
+            local_us = days * DAY_IN_SECS * SEC_IN_USECS;
+            break;
+        case UNIT_MONTH:
+        case UNIT_YEAR:
+            days = _floor_div(local_us, DAY_IN_SECS * SEC_IN_USECS);
+            _civil_from_days(days, &year, &month, &day);
+            days = _days_from_civil(year, unit == UNIT_YEAR ? 1 : month, 1);
+            local_us = days * DAY_IN_SECS * SEC_IN_USECS;
+            break;
+    }
+
+    return local_us - offset_us;
+}
+
+
+static const char *http_wday_names[7] = {
+    "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+};
+
+static const char *http_wday_long_names[7] = {
+    "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday",
+    "Saturday"
+};
+
+static const char *http_month_names[12] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+/*
+ * Create RFC 7231 IMF-fixdate HTTP-date string (HTTP_DATE_SIZE chars)
+ * Ex. Sun, 06 Nov 1994 08:49:37 GMT
+ *
+ * dt must be in UTC, time.offset and time.fraction are ignored.
+ */
+static void _format_http_date(date_time_struct *dt, char *http_date_string) {
+    long long days = _days_from_civil(
+        (*dt).date.year, (*dt).date.month, (*dt).date.day
     );
+
+    sprintf(
+        http_date_string,
+        "%s, %02u %s %04u %02u:%02u:%02u GMT",
+        http_wday_names[((days % 7) + 11) % 7],
+        (*dt).date.day % 100,
+        http_month_names[(*dt).date.month - 1],
+        (*dt).date.year % 10000,
+        (*dt).time.hour % 100,
+        (*dt).time.minute % 100,
+        (*dt).time.second % 100
+    );
+}
+
+/*
+ * Create HTTP-date string of the current time. The string is cached per
+ * thread and only rebuilt when the second changes.
+ */
+static void _http_date_now(char *http_date_string) {
+    static __thread long long cached_secs = LLONG_MIN;
+    static __thread char cached_string[HTTP_DATE_SIZE + 1];
+    long long secs = (long long)floor(_gettime());
+
+    if (secs != cached_secs) {
+        date_time_struct dt;
+        _timestamp_us_to_date_time(secs * SEC_IN_USECS, &dt, 0);
+        _format_http_date(&dt, cached_string);
+        cached_secs = secs;
+    }
+
+    memcpy(http_date_string, cached_string, HTTP_DATE_SIZE + 1);
 }
 
+/*
+ * Parse a HTTP-date, all formats recipients must accept (RFC 7231 7.1.1.1)
+ * IMF-fixdate  = Sun, 06 Nov 1994 08:49:37 GMT
+ * rfc850-date  = Sunday, 06-Nov-94 08:49:37 GMT
+ * asctime-date = Sun Nov  6 08:49:37 1994
+ *
+ * IMF-fixdate additionally accepts the RFC 2822 zones UT, UTC, Z and
+ * +hhmm/-hhmm. Names are case-insensitive, the day name is not checked
+ * against the date. A leap second (60) is set to 59.
+ */
+static void _parse_http_date(char *http_date_string, date_time_struct *dt) {
+    char wday[10] = {0};
+    char month_name[4] = {0};
+    char zone[6] = "GMT";
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    int length = 0, year_start = 0, i;
+
+    // invalidate date_time_struct
+    (*dt).date.ok = 0;
+    (*dt).time.ok = 0;
+    (*dt).ok = 0;
+
+    if (sscanf(http_date_string, "%9[A-Za-z], %2d %3[A-Za-z] %n%4d "
+               "%2d:%2d:%2d %5s%n", wday, &day, month_name, &year_start,
+               &year, &hour, &minute, &second, zone, &length) == 8 &&
+            length > 0) {
+        // 2 digit years only in RFC 850 dates
+        if (strlen(wday) != 3 ||
+                strspn(http_date_string + year_start, "0123456789") != 4)
+            return;
+    } else if (sscanf(http_date_string, "%9[A-Za-z], %2d-%3[A-Za-z]-%2d "
+                      "%2d:%2d:%2d %5s%n", wday, &day, month_name, &year,
+                      &hour, &minute, &second, zone, &length) == 8 &&
+            length > 0) {
+        year += year < 50 ? 2000 : 1900;
+        if (strlen(wday) == 3)
+            return;
+    } else if (sscanf(http_date_string, "%3[A-Za-z] %3[A-Za-z] %2d "
+                      "%2d:%2d:%2d %n%4d%n", wday, month_name, &day, &hour,
+                      &minute, &second, &year_start, &year, &length) == 7 &&
+            length > 0) {
+        if (strspn(http_date_string + year_start, "0123456789") != 4)
+            return;
+
+        strcpy(zone, "GMT");
+    } else {
+        return;
+    }
+
+    // only trailing spaces allowed
+    while (http_date_string[length] == ' ')
+        length++;
+    if (http_date_string[length] != 0)
+        return;
+
+    for (i = 0; i < 7; i++) {
+        if (strcasecmp(wday, http_wday_names[i]) == 0 ||
+                strcasecmp(wday, http_wday_long_names[i]) == 0)
+            break;
+    }
+    if (i == 7) return;
+
+    for (month = 0; month < 12; month++) {
+        if (strcasecmp(month_name, http_month_names[month]) == 0)
+            break;
+    }
+    if (month == 12) return;
+    month += 1;
+
+    // Validate date, day must survive the civil round trip
+    if (year < 1 || year > 9999 || day < 1 || day > 31) return;
+
+    long long days = _days_from_civil(year, month, day);
+    _civil_from_days(
+        days, &year, &((*dt).date.month), &((*dt).date.day)
+    );
+    if ((*dt).date.month != (unsigned int)month ||\
+            (*dt).date.day != (unsigned int)day)
+        return;
+
+    (*dt).date.year = year;
+    (*dt).date.wday = (unsigned int)(((days % 7) + 11) % 7) + 1;
+    (*dt).date.ok = 1;
+
+    // Validate time and zone
+    if (hour < 0 || hour > 23) return;
+    if (minute < 0 || minute > 59) return;
+    if (second < 0 || second > 60) return;
+
+    if (strcasecmp(zone, "GMT") == 0 || strcasecmp(zone, "UT") == 0 ||
+            strcasecmp(zone, "UTC") == 0 || strcasecmp(zone, "Z") == 0) {
+        (*dt).time.offset = 0;
+    } else if ((zone[0] == '+' || zone[0] == '-') && strlen(zone) == 5 &&
+               strspn(zone + 1, "0123456789") == 4) {
+        int offset_hour = (zone[1] - '0') * 10 + (zone[2] - '0');
+        int offset_minute = (zone[3] - '0') * 10 + (zone[4] - '0');
+
+        if (offset_hour > 23 || offset_minute > 59) return;
+
+        (*dt).time.offset = offset_hour * HOUR_IN_MINS + offset_minute;
+        if (zone[0] == '-')
+            (*dt).time.offset *= -1;
+    } else {
+        return;
+    }
+
+    (*dt).time.hour = hour;
+    (*dt).time.minute = minute;
+    (*dt).time.second = second > 59 ? 59 : second; // no leap seconds
+    (*dt).time.fraction = 0;
+    (*dt).time.ok = 1;
+
+    (*dt).ok = 1;
+}
 
 /*
  * ***======================= C API =======================***
@@ -506,6 +1139,17 @@ typedef struct {
     void (*utcnow)(date_time_struct*);
     void (*localnow)(date_time_struct*);
     int (*get_local_utc_offset)(void);
+    long long (*date_time_to_timestamp_us)(date_time_struct*);
+    long long (*floor_timestamp_us)(long long, int, int);
+    void (*timestamp_us_to_date_time)(long long, date_time_struct*, int);
+    void (*format_date_time_utc)(date_time_struct*, char*, unsigned int);
+    void (*format_date)(date_struct*, char*);
+    void (*pack_date_time)(date_time_struct*, unsigned char*);
+    void (*unpack_date_time)(const unsigned char*, date_time_struct*);
+    void (*format_http_date)(date_time_struct*, char*);
+    void (*parse_http_date)(char*, date_time_struct*);
+    void (*http_date_now)(char*);
+    long long (*date_time_diff_us)(date_time_struct*, date_time_struct*);
 } RFC3999_CAPI;
 
 extern RFC3999_CAPI CAPI = {
@@ -517,7 +1161,18 @@ extern RFC3999_CAPI CAPI = {
     _format_date_time,
     _utcnow,
     _localnow,
-    _get_local_utc_offset
+    _get_local_utc_offset,
+    _date_time_to_timestamp_us,
+    _floor_timestamp_us,
+    _timestamp_us_to_date_time,
+    _format_date_time_utc,
+    _format_date,
+    _pack_date_time,
+    _unpack_date_time,
+    _format_http_date,
+    _parse_http_date,
+    _http_date_now,
+    _date_time_diff_us
 };
 
 
@@ -526,6 +1181,10 @@ extern RFC3999_CAPI CAPI = {
  */
 
 #if defined(_PYTHON2) || defined(_PYTHON3)
+#ifdef _PYTHON3
+#define PyInt_FromLong PyLong_FromLong
+#endif
+
 /*
  * class FixedOffset(tzinfo):
  */
@@ -691,6 +1350,56 @@ static PyObject *new_fixed_offset_ex(int offset, PyTypeObject *type) {
 
 #define new_fixed_offset(offset) new_fixed_offset_ex(offset, &FixedOffset_type)
 
+/*
+ * Lightweight parse result, field-wise access without datetime/tzinfo
+ */
+static PyStructSequence_Field DateTimeTuple_fields[] = {
+    {"year", "year, 1 - 9999"},
+    {"month", "month of year, 1 - 12"},
+    {"day", "day of month, 1 - 31"},
+    {"hour", "hour, 0 - 23"},
+    {"minute", "minute, 0 - 59"},
+    {"second", "second, 0 - 59"},
+    {"usec", "microsecond, 0 - 999999"},
+    {"offset", "UTC offset in minutes"},
+    {"wday", "day of week, 1 - 7, Sunday is 1"},
+    {NULL}
+};
+
+static PyStructSequence_Desc DateTimeTuple_desc = {
+    "udatetime.rfc3339.DateTimeTuple",
+    "RFC3339 date-time components",
+    DateTimeTuple_fields,
+    9
+};
+
+static PyTypeObject DateTimeTuple_type;
+static PyTypeObject UDateTime_type;
+
+static PyObject *dtstruct_to_datetime_tuple(date_time_struct *dt) {
+    PyObject *tuple = PyStructSequence_New(&DateTimeTuple_type);
+
+    if (tuple == NULL)
+        return NULL;
+
+    PyStructSequence_SET_ITEM(tuple, 0, PyInt_FromLong((*dt).date.year));
+    PyStructSequence_SET_ITEM(tuple, 1, PyInt_FromLong((*dt).date.month));
+    PyStructSequence_SET_ITEM(tuple, 2, PyInt_FromLong((*dt).date.day));
+    PyStructSequence_SET_ITEM(tuple, 3, PyInt_FromLong((*dt).time.hour));
+    PyStructSequence_SET_ITEM(tuple, 4, PyInt_FromLong((*dt).time.minute));
+    PyStructSequence_SET_ITEM(tuple, 5, PyInt_FromLong((*dt).time.second));
+    PyStructSequence_SET_ITEM(tuple, 6, PyInt_FromLong((*dt).time.fraction));
+    PyStructSequence_SET_ITEM(tuple, 7, PyInt_FromLong((*dt).time.offset));
+    PyStructSequence_SET_ITEM(tuple, 8, PyInt_FromLong((*dt).date.wday));
+
+    if (PyErr_Occurred()) {
+        Py_DECREF(tuple);
+        return NULL;
+    }
+
+    return tuple;
+}
+
 static PyObject *dtstruct_to_datetime_obj(date_time_struct *dt) {
     if ((*dt).ok == 1) {
         PyObject *offset = new_fixed_offset((*dt).time.offset);
@@ -717,47 +1426,1549 @@ static PyObject *dtstruct_to_datetime_obj(date_time_struct *dt) {
     return Py_None;
 }
 
-static void check_timestamp_platform_support(double timestamp) {
-    double diff = timestamp - (double)((time_t)timestamp);
+/*
+ * Hot path counters per entry point, compiled in with -DUDATETIME_STATS
+ * (UDATETIME_STATS=1 python setup.py build). Relaxed atomics, counts are
+ * exact but not a consistent snapshot across counters.
+ */
+#define STATS_FROM_STRING 0
+#define STATS_FROM_STRING_TUPLE 1
+#define STATS_STRING_TO_TIMESTAMP 2
+#define STATS_IS_VALID 3
+#define STATS_VALIDATE_MANY 4
+#define STATS_NORMALIZE_MANY 5
+#define STATS_TO_STRING 6
+#define STATS_UTCNOW 7
+#define STATS_NOW 8
+#define STATS_UTCNOW_TO_STRING 9
+#define STATS_NOW_TO_STRING 10
+#define STATS_DIFF_US 11
+#define STATS_DIFF_MANY 12
+#define STATS_TO_TIMESTAMP 13
+#define STATS_FROM_TIMESTAMP 14
+#define STATS_FROM_UTCTIMESTAMP 15
+#define STATS_FLOOR_TIMESTAMPS_US 16
+#define STATS_ENCODE_DATETIMES 17
+#define STATS_TO_BYTES 18
+#define STATS_FROM_BYTES 19
+#define STATS_TO_BYTES_MANY 20
+#define STATS_FROM_BYTES_MANY 21
+#define STATS_TIMESTAMPS_TO_STRINGS 22
+#define STATS_STRINGS_TO_COMPONENTS 23
+#define STATS_TO_HTTP_DATE 24
+#define STATS_UTCNOW_TO_HTTP_DATE 25
+#define STATS_FROM_HTTP_DATE 26
+#define STATS_STRING_CACHE 27
+#define STATS_ENTRIES 28
+
+#ifdef UDATETIME_STATS
+static const char *stats_names[STATS_ENTRIES] = {
+    "from_string",
+    "from_string_tuple",
+    "string_to_timestamp",
+    "is_valid",
+    "validate_many",
+    "normalize_many",
+    "to_string",
+    "utcnow",
+    "now",
+    "utcnow_to_string",
+    "now_to_string",
+    "diff_us",
+    "diff_many",
+    "to_timestamp",
+    "fromtimestamp",
+    "utcfromtimestamp",
+    "floor_timestamps_us",
+    "encode_datetimes",
+    "to_bytes",
+    "from_bytes",
+    "to_bytes_many",
+    "from_bytes_many",
+    "timestamps_to_strings",
+    "strings_to_components",
+    "to_http_date",
+    "utcnow_to_http_date",
+    "from_http_date",
+    "string_cache"
+};
 
-    if (diff <= -1.0 || diff >= 1.0) {
-        PyErr_SetString(
-            PyExc_ValueError, "timestamp out of range for platform time_t"
-        );
-    }
-}
+typedef struct {
+    unsigned long long calls;
+    unsigned long long date_invalid;
+    unsigned long long time_invalid;
+    unsigned long long fast_path;
+    unsigned long long fallback;
+    unsigned long long bytes;
+} stats_struct;
+
+static stats_struct stats[STATS_ENTRIES];
+
+#define STATS_ADD(entry, counter, n)\
+    __atomic_fetch_add(&(stats[entry].counter), (n), __ATOMIC_RELAXED)
+
+// count invalid input, split like check_date_time_struct
+#define STATS_INVALID(entry, dt) do {\
+    if ((dt).date.ok != 1)\
+        STATS_ADD(entry, date_invalid, 1);\
+    else if ((dt).time.ok != 1)\
+        STATS_ADD(entry, time_invalid, 1);\
+} while (0)
+
+// count parsed input
+#define STATS_PARSED(entry, dt, string) do {\
+    STATS_ADD(entry, bytes, strlen(string));\
+    STATS_INVALID(entry, dt);\
+} while (0)
+#else
+#define STATS_ADD(entry, counter, n) do {} while (0)
+#define STATS_INVALID(entry, dt) do {} while (0)
+#define STATS_PARSED(entry, dt, string) do {} while (0)
+#endif
 
-static void check_date_time_struct(date_time_struct *dt) {
-    if ((*dt).ok != 1) {
-        if ((*dt).date.ok != 1) {
-            PyErr_SetString(
-                PyExc_ValueError,
-                "Invalid RFC3339 date-time string. Date invalid."
-            );
-        } else if ((*dt).time.ok != 1) {
-            PyErr_SetString(
-                PyExc_ValueError,
-                "Invalid RFC3339 date-time string. Time invalid."
-            );
-        } else {
-            PyErr_SetString(PyExc_ValueError, "Not supposed to happen!");
-        }
-    }
-}
+/*
+ * Get a C-contiguous buffer of native int64 items. Accepts int64 typed
+ * buffers (e.g. array('q'), numpy int64 or datetime64[us] viewed as int64)
+ * and raw byte buffers with a length multiple of 8. Sets a Python
+ * exception and returns -1 on error.
+ */
+static int get_int64_buffer(PyObject *obj, Py_buffer *view, int writable) {
+    int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT;
 
-static PyObject *utcnow(PyObject *self) {
-    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
-    _utcnow(&dt);
-    return dtstruct_to_datetime_obj(&dt);
-}
+    if (writable)
+        flags |= PyBUF_WRITABLE;
 
-static PyObject *localnow(PyObject *self) {
+    if (PyObject_GetBuffer(obj, view, flags) < 0)
+        return -1;
+
+    const char *format = view->format ? view->format : "B";
+
+    if (*format == '@' || *format == '=')
+        format++;
+
+    if (view->itemsize == 8 && (strcmp(format, "q") == 0 ||
+                                strcmp(format, "l") == 0))
+        return 0;
+
+    if (view->itemsize == 1 && view->len % 8 == 0 &&
+            (strcmp(format, "B") == 0 || strcmp(format, "b") == 0 ||
+             strcmp(format, "c") == 0))
+        return 0;
+
+    PyBuffer_Release(view);
+    PyErr_SetString(PyExc_TypeError, "Expected a buffer of int64 items.");
+    return -1;
+}
+
+/*
+ * Get a writable C-contiguous buffer of native int32 or int64 items
+ * (e.g. array('i'), array('q'), numpy int32/int64). Sets a Python
+ * exception and returns -1 on error.
+ */
+static int get_int_buffer(PyObject *obj, Py_buffer *view) {
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT |\
+                           PyBUF_WRITABLE) < 0)
+        return -1;
+
+    const char *format = view->format ? view->format : "B";
+
+    if (*format == '@' || *format == '=')
+        format++;
+
+    if ((view->itemsize == 4 || view->itemsize == 8) &&
+            (strcmp(format, "i") == 0 || strcmp(format, "l") == 0 ||
+             strcmp(format, "q") == 0))
+        return 0;
+
+    PyBuffer_Release(view);
+    PyErr_SetString(
+        PyExc_TypeError, "Expected a buffer of int32 or int64 items."
+    );
+    return -1;
+}
+
+/*
+ * UTF-8 contents of a str object. Returns NULL with a Python exception set
+ * for other objects and for strings containing NUL, which the sscanf based
+ * parsing would silently truncate.
+ */
+static const char *get_rfc3339_string(PyObject *obj) {
+    const char *rfc3339_string = NULL;
+    Py_ssize_t length = 0;
+
+#ifdef _PYTHON3
+    rfc3339_string = PyUnicode_AsUTF8AndSize(obj, &length);
+#else
+    if (PyString_AsStringAndSize(obj, (char **)&rfc3339_string, &length) < 0)
+        return NULL;
+#endif
+    if (rfc3339_string == NULL)
+        return NULL;
+
+    if (strlen(rfc3339_string) != (size_t)length) {
+        PyErr_SetString(PyExc_ValueError, "embedded null character");
+        return NULL;
+    }
+
+    return rfc3339_string;
+}
+
+static void check_timestamp_platform_support(double timestamp) {
+    double diff = timestamp - (double)((time_t)timestamp);
+
+    if (diff <= -1.0 || diff >= 1.0) {
+        PyErr_SetString(
+            PyExc_ValueError, "timestamp out of range for platform time_t"
+        );
+    }
+}
+
+static void check_date_time_struct(date_time_struct *dt) {
+    if ((*dt).ok != 1) {
+        if ((*dt).date.ok != 1) {
+            PyErr_SetString(
+                PyExc_ValueError,
+                "Invalid RFC3339 date-time string. Date invalid."
+            );
+        } else if ((*dt).time.ok != 1) {
+            PyErr_SetString(
+                PyExc_ValueError,
+                "Invalid RFC3339 date-time string. Time invalid."
+            );
+        } else {
+            PyErr_SetString(PyExc_ValueError, "Not supposed to happen!");
+        }
+    }
+}
+
+// like check_date_time_struct, for date-times unpacked from bytes
+static void check_packed_date_time(date_time_struct *dt) {
+    if ((*dt).ok != 1) {
+        if ((*dt).date.ok != 1) {
+            PyErr_SetString(
+                PyExc_ValueError,
+                "Invalid packed date-time. Timestamp out of range."
+            );
+        } else {
+            PyErr_SetString(
+                PyExc_ValueError,
+                "Invalid packed date-time. Offset out of range."
+            );
+        }
+    }
+}
+
+static PyObject *utcnow(PyObject *self) {
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    STATS_ADD(STATS_UTCNOW, calls, 1);
+
+    if (_coarse_clock_read(&dt, NULL, NULL, NULL)) {
+        STATS_ADD(STATS_UTCNOW, fast_path, 1);
+    } else {
+        STATS_ADD(STATS_UTCNOW, fallback, 1);
+        _utcnow(&dt);
+    }
+    return dtstruct_to_datetime_obj(&dt);
+}
+
+static PyObject *localnow(PyObject *self) {
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    STATS_ADD(STATS_NOW, calls, 1);
+
+    if (_coarse_clock_read(NULL, &dt, NULL, NULL)) {
+        STATS_ADD(STATS_NOW, fast_path, 1);
+    } else {
+        STATS_ADD(STATS_NOW, fallback, 1);
+        _localnow(&dt);
+    }
+    return dtstruct_to_datetime_obj(&dt);
+}
+
+static PyObject *parse_to_datetime_obj(char *rfc3339_string,
+                                       int stats_entry) {
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    _parse_date_time(rfc3339_string, &dt);
+    STATS_PARSED(stats_entry, dt, rfc3339_string);
+
+    check_date_time_struct(&dt);
+    if(PyErr_Occurred())
+        return NULL;
+
+    return dtstruct_to_datetime_obj(&dt);
+}
+
+/*
+ * class StringCache:
+ * Bounded, direct-mapped cache of parsed RFC3339 strings. A slot is picked
+ * by the string's hash and holds the string and the datetime built from it,
+ * a colliding miss replaces the slot. Caches are used with the GIL held and
+ * need no lock. Use one cache per thread or per call site for scoping, or
+ * the module wide cache of from_string(), see enable_string_cache().
+ */
+typedef struct {
+    PyObject *key;
+    PyObject *value;
+    Py_ssize_t hash;
+} string_cache_entry;
+
+typedef struct {
+    PyObject_HEAD
+    string_cache_entry *entries;
+    Py_ssize_t mask;
+    unsigned long long hits;
+    unsigned long long misses;
+} StringCache;
+
+static PyTypeObject StringCache_type;
+static StringCache *string_cache = NULL; // used by from_rfc3339_string
+
+static void StringCache_clear_entries(StringCache *self) {
+    if (self->entries == NULL)
+        return;
+
+    for (Py_ssize_t i = 0; i <= self->mask; i++) {
+        Py_CLEAR(self->entries[i].key);
+        Py_CLEAR(self->entries[i].value);
+    }
+}
+
+/*
+ * def __init__(self, size=1024):
+ * size is rounded up to the next power of 2
+ */
+static int StringCache_init(StringCache *self, PyObject *args,
+                            PyObject *kwargs) {
+    Py_ssize_t size = 1024;
+    static char *keywords[] = {"size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|n", keywords, &size))
+        return -1;
+
+    if (size < 1 || size > (1 << 24)) {
+        PyErr_SetString(PyExc_ValueError, "size must be 1 - 16777216.");
+        return -1;
+    }
+
+    Py_ssize_t slots = 1;
+    while (slots < size)
+        slots <<= 1;
+
+    string_cache_entry *entries = PyMem_Malloc(
+        slots * sizeof(string_cache_entry)
+    );
+
+    if (entries == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    memset(entries, 0, slots * sizeof(string_cache_entry));
+
+    StringCache_clear_entries(self);
+    PyMem_Free(self->entries);
+
+    self->entries = entries;
+    self->mask = slots - 1;
+    self->hits = 0;
+    self->misses = 0;
+    return 0;
+}
+
+static void StringCache_dealloc(StringCache *self) {
+    StringCache_clear_entries(self);
+    PyMem_Free(self->entries);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+/*
+ * Cached from_rfc3339_string counted under stats_entry, hits as fast_path
+ * and misses as fallback, returns a new reference. Comparing keys and
+ * parsing can run Python code that clears, resizes or drops the cache, the
+ * caller holds a reference to self and entries are looked up again after.
+ */
+static PyObject *string_cache_lookup_ex(StringCache *self, PyObject *string,
+                                        int stats_entry) {
+#ifdef _PYTHON3
+    if (!PyUnicode_Check(string)) {
+#else
+    if (!PyString_Check(string)) {
+#endif
+        PyErr_SetString(PyExc_TypeError, "Expected a str.");
+        return NULL;
+    }
+
+    Py_ssize_t hash = PyObject_Hash(string);
+    if (hash == -1)
+        return NULL;
+
+    if (self->entries == NULL) {
+        PyErr_SetString(PyExc_ValueError, "StringCache not initialized.");
+        return NULL;
+    }
+
+    string_cache_entry *entry = &(self->entries[hash & self->mask]);
+
+    if (entry->key != NULL && entry->hash == hash) {
+        PyObject *key = entry->key;
+        PyObject *value = entry->value;
+
+        Py_INCREF(key);
+        Py_INCREF(value);
+        int equal = key == string ?\
+            1 : PyObject_RichCompareBool(key, string, Py_EQ);
+        Py_DECREF(key);
+
+        if (equal > 0) {
+            self->hits++;
+            STATS_ADD(stats_entry, fast_path, 1);
+            return value;
+        }
+
+        Py_DECREF(value);
+        if (equal < 0)
+            return NULL;
+    }
+
+    self->misses++;
+    STATS_ADD(stats_entry, fallback, 1);
+
+    const char *rfc3339_string = get_rfc3339_string(string);
+    if (rfc3339_string == NULL)
+        return NULL;
+
+    PyObject *value = parse_to_datetime_obj(
+        (char *)rfc3339_string, stats_entry
+    );
+    if (value == NULL || self->entries == NULL)
+        return value;
+
+    entry = &(self->entries[hash & self->mask]);
+
+    PyObject *old_key = entry->key;
+    PyObject *old_value = entry->value;
+
+    Py_INCREF(string);
+    Py_INCREF(value);
+    entry->key = string;
+    entry->value = value;
+    entry->hash = hash;
+
+    Py_XDECREF(old_key);
+    Py_XDECREF(old_value);
+    return value;
+}
+
+static PyObject *string_cache_lookup(StringCache *self, PyObject *string,
+                                     int stats_entry) {
+    Py_INCREF(self);
+    PyObject *value = string_cache_lookup_ex(self, string, stats_entry);
+    Py_DECREF(self);
+    return value;
+}
+
+/*
+ * def from_string(self, rfc3339_string):
+ */
+static PyObject *StringCache_from_string(StringCache *self, PyObject *args) {
+    PyObject *string;
+
+    if (!PyArg_ParseTuple(args, "O", &string))
+        return NULL;
+
+    STATS_ADD(STATS_STRING_CACHE, calls, 1);
+    return string_cache_lookup(self, string, STATS_STRING_CACHE);
+}
+
+/*
+ * def clear(self):
+ */
+static PyObject *StringCache_clear(StringCache *self) {
+    StringCache_clear_entries(self);
+    self->hits = 0;
+    self->misses = 0;
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyMemberDef StringCache_members[] = {
+    {"hits", T_ULONGLONG, offsetof(StringCache, hits), READONLY, "Hits"},
+    {"misses", T_ULONGLONG, offsetof(StringCache, misses), READONLY,
+     "Misses"},
+    {NULL}
+};
+
+static PyMethodDef StringCache_methods[] = {
+    {"from_string", (PyCFunction)StringCache_from_string, METH_VARARGS,
+     "Parse RFC3339 compliant date-time string, cached."},
+    {"clear",       (PyCFunction)StringCache_clear,       METH_NOARGS,
+     "Drop all cached entries and reset hits and misses."},
+    {NULL}
+};
+
+#ifdef _PYTHON3
+static PyTypeObject StringCache_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "rfc3339.StringCache",                  /* tp_name */
+    sizeof(StringCache),                    /* tp_basicsize */
+    0,                                      /* tp_itemsize */
+    (destructor)StringCache_dealloc,        /* tp_dealloc */
+    0,                                      /* tp_print */
+    0,                                      /* tp_getattr */
+    0,                                      /* tp_setattr */
+    0,                                      /* tp_as_async */
+    0,                                      /* tp_repr */
+    0,                                      /* tp_as_number */
+    0,                                      /* tp_as_sequence */
+    0,                                      /* tp_as_mapping */
+    0,                                      /* tp_hash  */
+    0,                                      /* tp_call */
+    0,                                      /* tp_str */
+    0,                                      /* tp_getattro */
+    0,                                      /* tp_setattro */
+    0,                                      /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                     /* tp_flags */
+    "Bounded cache of parsed RFC3339 strings", /* tp_doc */
+};
+#else
+static PyTypeObject StringCache_type = {
+    PyObject_HEAD_INIT(NULL)
+    0,                         /*ob_size*/
+    "rfc3339.StringCache",     /*tp_name*/
+    sizeof(StringCache),       /*tp_basicsize*/
+    0,                         /*tp_itemsize*/
+    (destructor)StringCache_dealloc, /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    0,                         /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT,        /*tp_flags*/
+    "Bounded cache of parsed RFC3339 strings", /* tp_doc */
+};
+#endif
+
+/*
+ * class UDateTime:
+ * Compact date-time, microseconds since epoch (UTC) and UTC offset in
+ * minutes without tzinfo object. A datetime is only built by to_datetime().
+ */
+typedef struct {
+    PyObject_HEAD
+    long long timestamp_us;
+    int offset;
+} UDateTime;
+
+static PyObject *new_udatetime(long long timestamp_us, int offset) {
+    /* local time must stay within 0001-01-01 - 9999-12-31 */
+    long long local_us = timestamp_us + offset * 60 * SEC_IN_USECS;
+
+    if (timestamp_us < MIN_TIMESTAMP_US || timestamp_us > MAX_TIMESTAMP_US ||
+            offset <= -24 * HOUR_IN_MINS || offset >= 24 * HOUR_IN_MINS ||
+            local_us < MIN_TIMESTAMP_US + DAY_IN_SECS * SEC_IN_USECS ||
+            local_us > MAX_TIMESTAMP_US - DAY_IN_SECS * SEC_IN_USECS +
+                       SEC_IN_USECS - 1) {
+        PyErr_SetString(PyExc_OverflowError, "date value out of range");
+        return NULL;
+    }
+
+    UDateTime *self = (UDateTime *)(
+        UDateTime_type.tp_alloc(&UDateTime_type, 0)
+    );
+
+    if (self == NULL)
+        return NULL;
+
+    self->timestamp_us = timestamp_us;
+    self->offset = offset;
+    return (PyObject *)self;
+}
+
+#define dtstruct_to_udatetime(dt)\
+    new_udatetime(_date_time_to_timestamp_us(dt), (*(dt)).time.offset)
+
+/*
+ * def __new__(cls, timestamp_us, offset=0):
+ */
+static PyObject *UDateTime_new(PyTypeObject *type, PyObject *args,
+                               PyObject *kwargs) {
+    long long timestamp_us;
+    int offset = 0;
+    static char *keywords[] = {"timestamp_us", "offset", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "L|i", keywords,
+                                     &timestamp_us, &offset))
+        return NULL;
+
+    return new_udatetime(timestamp_us, offset);
+}
+
+static void UDateTime_to_dtstruct(UDateTime *self, date_time_struct *dt) {
+    _timestamp_us_to_date_time(self->timestamp_us, dt, self->offset);
+}
+
+/*
+ * def to_string(self):
+ */
+static PyObject *UDateTime_to_string(UDateTime *self) {
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    UDateTime_to_dtstruct(self, &dt);
+
+    char datetime_string[33] = {0};
+    _format_date_time(&dt, datetime_string);
+
+#ifdef _PYTHON3
+    return PyUnicode_FromString(datetime_string);
+#else
+    return PyString_FromString(datetime_string);
+#endif
+}
+
+/*
+ * def timestamp(self):
+ */
+static PyObject *UDateTime_timestamp(UDateTime *self) {
+    return PyFloat_FromDouble((double)self->timestamp_us / 1000000.0);
+}
+
+/*
+ * def to_datetime(self):
+ */
+static PyObject *UDateTime_to_datetime(UDateTime *self) {
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    UDateTime_to_dtstruct(self, &dt);
+    return dtstruct_to_datetime_obj(&dt);
+}
+
+/*
+ * def __reduce__(self):
+ */
+static PyObject *UDateTime_reduce(UDateTime *self) {
+    return Py_BuildValue(
+        "(O(Li))", Py_TYPE(self), self->timestamp_us, self->offset
+    );
+}
+
+static PyObject *UDateTime_repr(UDateTime *self) {
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    UDateTime_to_dtstruct(self, &dt);
+
+    char datetime_string[33] = {0};
+    _format_date_time(&dt, datetime_string);
+
+#ifdef _PYTHON3
+    return PyUnicode_FromFormat("UDateTime('%s')", datetime_string);
+#else
+    return PyString_FromFormat("UDateTime('%s')", datetime_string);
+#endif
+}
+
+/*
+ * Ordering and hash by instant, like aware datetime objects
+ */
+static PyObject *UDateTime_richcompare(PyObject *a, PyObject *b, int op) {
+    if (Py_TYPE(a) != &UDateTime_type || Py_TYPE(b) != &UDateTime_type) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    long long x = ((UDateTime *)a)->timestamp_us;
+    long long y = ((UDateTime *)b)->timestamp_us;
+    int result = 0;
+
+    switch (op) {
+        case Py_LT: result = x < y; break;
+        case Py_LE: result = x <= y; break;
+        case Py_EQ: result = x == y; break;
+        case Py_NE: result = x != y; break;
+        case Py_GT: result = x > y; break;
+        case Py_GE: result = x >= y; break;
+    }
+
+    return PyBool_FromLong(result);
+}
+
+static long UDateTime_hash(UDateTime *self) {
+    long long timestamp_us = self->timestamp_us;
+    long hash = (long)(timestamp_us ^ (timestamp_us >> 32));
+
+    return hash == -1 ? -2 : hash;
+}
+
+/*
+ * timedelta in microseconds, sets OverflowError and returns -1 if it
+ * exceeds the supported date range (and would overflow int64 in us)
+ */
+static int timedelta_to_us(PyObject *delta, long long *delta_us) {
+    const long long max_days = (MAX_TIMESTAMP_US - MIN_TIMESTAMP_US) /
+        (DAY_IN_SECS * SEC_IN_USECS) + 1;
+    long long days = ((PyDateTime_Delta *)delta)->days;
+
+    if (days < -max_days || days > max_days) {
+        PyErr_SetString(PyExc_OverflowError, "date value out of range");
+        return -1;
+    }
+
+    *delta_us = (days * DAY_IN_SECS + ((PyDateTime_Delta *)delta)->seconds) *
+        SEC_IN_USECS + ((PyDateTime_Delta *)delta)->microseconds;
+    return 0;
+}
+
+/*
+ * UDateTime - UDateTime -> timedelta, UDateTime - timedelta -> UDateTime
+ */
+static PyObject *UDateTime_subtract(PyObject *a, PyObject *b) {
+    if (Py_TYPE(a) == &UDateTime_type && Py_TYPE(b) == &UDateTime_type) {
+        long long diff = ((UDateTime *)a)->timestamp_us -\
+            ((UDateTime *)b)->timestamp_us;
+        long long days = _floor_div(diff, DAY_IN_SECS * SEC_IN_USECS);
+        long long rest = diff - days * DAY_IN_SECS * SEC_IN_USECS;
+
+        return PyDelta_FromDSU(
+            (int)days, (int)(rest / SEC_IN_USECS), (int)(rest % SEC_IN_USECS)
+        );
+    }
+
+    if (Py_TYPE(a) == &UDateTime_type && PyDelta_Check(b)) {
+        long long delta_us;
+
+        if (timedelta_to_us(b, &delta_us) < 0)
+            return NULL;
+
+        return new_udatetime(
+            ((UDateTime *)a)->timestamp_us - delta_us,
+            ((UDateTime *)a)->offset
+        );
+    }
+
+    Py_INCREF(Py_NotImplemented);
+    return Py_NotImplemented;
+}
+
+/*
+ * UDateTime + timedelta -> UDateTime
+ */
+static PyObject *UDateTime_add(PyObject *a, PyObject *b) {
+    if (Py_TYPE(a) != &UDateTime_type) {
+        PyObject *swap = a;
+        a = b;
+        b = swap;
+    }
+
+    if (Py_TYPE(a) == &UDateTime_type && PyDelta_Check(b)) {
+        long long delta_us;
+
+        if (timedelta_to_us(b, &delta_us) < 0)
+            return NULL;
+
+        return new_udatetime(
+            ((UDateTime *)a)->timestamp_us + delta_us,
+            ((UDateTime *)a)->offset
+        );
+    }
+
+    Py_INCREF(Py_NotImplemented);
+    return Py_NotImplemented;
+}
+
+static PyNumberMethods UDateTime_as_number = {
+    (binaryfunc)UDateTime_add,      /* nb_add */
+    (binaryfunc)UDateTime_subtract, /* nb_subtract */
+};
+
+static PyMemberDef UDateTime_members[] = {
+    {"timestamp_us", T_LONGLONG, offsetof(UDateTime, timestamp_us), READONLY,
+     "Microseconds since epoch"},
+    {"offset", T_INT, offsetof(UDateTime, offset), READONLY,
+     "UTC offset in minutes"},
+    {NULL}
+};
+
+static PyMethodDef UDateTime_methods[] = {
+    {"to_string",   (PyCFunction)UDateTime_to_string,   METH_NOARGS,
+     "RFC3339 compliant date-time string."},
+    {"timestamp",   (PyCFunction)UDateTime_timestamp,   METH_NOARGS,
+     "POSIX timestamp."},
+    {"to_datetime", (PyCFunction)UDateTime_to_datetime, METH_NOARGS,
+     "datetime aware object with TZFixedOffset."},
+    {"__reduce__",  (PyCFunction)UDateTime_reduce,      METH_NOARGS, ""},
+    {NULL}
+};
+
+#ifdef _PYTHON3
+static PyTypeObject UDateTime_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "udatetime.rfc3339.UDateTime",          /* tp_name */
+    sizeof(UDateTime),                      /* tp_basicsize */
+    0,                                      /* tp_itemsize */
+    0,                                      /* tp_dealloc */
+    0,                                      /* tp_print */
+    0,                                      /* tp_getattr */
+    0,                                      /* tp_setattr */
+    0,                                      /* tp_as_async */
+    (reprfunc)UDateTime_repr,               /* tp_repr */
+    &UDateTime_as_number,                   /* tp_as_number */
+    0,                                      /* tp_as_sequence */
+    0,                                      /* tp_as_mapping */
+    (hashfunc)UDateTime_hash,               /* tp_hash  */
+    0,                                      /* tp_call */
+    (reprfunc)UDateTime_to_string,          /* tp_str */
+    0,                                      /* tp_getattro */
+    0,                                      /* tp_setattro */
+    0,                                      /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                     /* tp_flags */
+    "Compact date-time with fixed UTC offset", /* tp_doc */
+};
+#else
+static PyTypeObject UDateTime_type = {
+    PyObject_HEAD_INIT(NULL)
+    0,                         /*ob_size*/
+    "udatetime.rfc3339.UDateTime", /*tp_name*/
+    sizeof(UDateTime),         /*tp_basicsize*/
+    0,                         /*tp_itemsize*/
+    0,                         /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    (reprfunc)UDateTime_repr,  /*tp_repr*/
+    &UDateTime_as_number,      /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    (hashfunc)UDateTime_hash,  /*tp_hash */
+    0,                         /*tp_call*/
+    (reprfunc)UDateTime_to_string, /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT |
+    Py_TPFLAGS_CHECKTYPES,     /*tp_flags*/
+    "Compact date-time with fixed UTC offset", /* tp_doc */
+};
+#endif
+
+static PyObject *from_rfc3339_string(PyObject *self, PyObject *args,
+                                     PyObject *kw) {
+    STATS_ADD(STATS_FROM_STRING, calls, 1);
+
+    if (string_cache != NULL && kw == NULL && PyTuple_GET_SIZE(args) == 1) {
+        return string_cache_lookup(
+            string_cache, PyTuple_GET_ITEM(args, 0), STATS_FROM_STRING
+        );
+    }
+
+    char *rfc3339_string;
+    int compact = 0;
+    static char *keywords[] = {"rfc3339_string", "compact", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "s|i", keywords,
+                                     &rfc3339_string, &compact))
+        return NULL;
+
+    if (!compact)
+        return parse_to_datetime_obj(rfc3339_string, STATS_FROM_STRING);
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    _parse_date_time(rfc3339_string, &dt);
+    STATS_PARSED(STATS_FROM_STRING, dt, rfc3339_string);
+
+    check_date_time_struct(&dt);
+    if(PyErr_Occurred())
+        return NULL;
+
+    return dtstruct_to_udatetime(&dt);
+}
+
+static PyObject *enable_string_cache(PyObject *self, PyObject *args,
+                                     PyObject *kw) {
+    StringCache *cache = (StringCache *)PyObject_Call(
+        (PyObject *)&StringCache_type, args, kw
+    );
+
+    if (cache == NULL)
+        return NULL;
+
+    StringCache *old_cache = string_cache;
+    string_cache = cache;
+    Py_XDECREF(old_cache);
+
+    Py_INCREF(cache);
+    return (PyObject *)cache;
+}
+
+static PyObject *disable_string_cache(PyObject *self) {
+    Py_CLEAR(string_cache);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+/*
+ * Fill date_time_struct from a datetime object, reading the packed
+ * PyDateTime_DateTime->data[] fields directly. Sets a Python exception and
+ * returns -1 on error.
+ */
+static int datetime_obj_to_dtstruct(PyObject *obj, date_time_struct *dt) {
+    if (Py_TYPE(obj) == &UDateTime_type) {
+        UDateTime_to_dtstruct((UDateTime *)obj, dt);
+        return 0;
+    }
+
+    if (!PyDateTime_Check(obj)) {
+        PyErr_SetString(PyExc_ValueError, "Expected a datetime object.");
+        return -1;
+    }
+
+    PyDateTime_DateTime *datetime_obj = (PyDateTime_DateTime *)obj;
+    int offset = 0;
+
+    // TODO: Support all tzinfo subclasses by calling utcoffset()
+    if (datetime_obj->hastzinfo) {
+        if (Py_TYPE(datetime_obj->tzinfo) == &FixedOffset_type) {
+            FixedOffset *tzinfo = (FixedOffset *)datetime_obj->tzinfo;
+            offset = tzinfo->offset;
+        } else {
+            PyErr_SetString(PyExc_ValueError, "Only TZFixedOffset supported.");
+            return -1;
+        }
+    }
+
+    (*dt).date.year = (datetime_obj->data[0] << 8) | datetime_obj->data[1];
+    (*dt).date.month = datetime_obj->data[2];
+    (*dt).date.day = datetime_obj->data[3];
+    (*dt).date.wday = 0; // wday, not needed
+    (*dt).date.ok = 1;
+
+    (*dt).time.hour = datetime_obj->data[4];
+    (*dt).time.minute = datetime_obj->data[5];
+    (*dt).time.second = datetime_obj->data[6];
+    (*dt).time.fraction = (datetime_obj->data[7] << 16) |\
+        (datetime_obj->data[8] << 8) |\
+        datetime_obj->data[9];
+    (*dt).time.offset = offset;
+    (*dt).time.ok = 1;
+
+    (*dt).ok = 1;
+    return 0;
+}
+
+static PyObject *from_rfc3339_string_tuple(PyObject *self, PyObject *args) {
+    char *rfc3339_string;
+
+    if (!PyArg_ParseTuple(args, "s", &rfc3339_string))
+        return NULL;
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    _parse_date_time(rfc3339_string, &dt);
+    STATS_ADD(STATS_FROM_STRING_TUPLE, calls, 1);
+    STATS_PARSED(STATS_FROM_STRING_TUPLE, dt, rfc3339_string);
+
+    check_date_time_struct(&dt);
+    if(PyErr_Occurred())
+        return NULL;
+
+    return dtstruct_to_datetime_tuple(&dt);
+}
+
+static PyObject *to_rfc3339_string(PyObject *self, PyObject *args) {
+    PyObject *obj = NULL;
+
+    if (!PyArg_ParseTuple(args, "O", &obj))
+        return NULL;
+
+    STATS_ADD(STATS_TO_STRING, calls, 1);
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    if (datetime_obj_to_dtstruct(obj, &dt) < 0)
+        return NULL;
+
+    STATS_ADD(STATS_TO_STRING, bytes, DATE_TIME_STRING_SIZE);
+
+    char datetime_string[33] = {0};
+    _format_date_time(&dt, datetime_string);
+
+#ifdef _PYTHON3
+    return PyUnicode_FromString(datetime_string);
+#else
+    return PyString_FromString(datetime_string);
+#endif
+}
+
+/*
+ * datetime -> RFC3339 date-time string, date -> RFC3339 full-date string.
+ * Returns a new reference, NULL with exception set on error or Py_None
+ * (new reference, no exception) if obj is neither.
+ */
+static PyObject *datetime_or_date_to_string(PyObject *obj, int dates) {
+    if (PyDateTime_Check(obj) || Py_TYPE(obj) == &UDateTime_type) {
+        date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+        if (datetime_obj_to_dtstruct(obj, &dt) < 0)
+            return NULL;
+
+        char datetime_string[33] = {0};
+        _format_date_time(&dt, datetime_string);
+
+#ifdef _PYTHON3
+        return PyUnicode_FromString(datetime_string);
+#else
+        return PyString_FromString(datetime_string);
+#endif
+    }
+
+    if (dates && PyDate_Check(obj)) {
+        date_struct d = {
+            PyDateTime_GET_YEAR(obj),
+            PyDateTime_GET_MONTH(obj),
+            PyDateTime_GET_DAY(obj),
+            0,
+            1
+        };
+
+        char date_string[11] = {0};
+        _format_date(&d, date_string);
+
+#ifdef _PYTHON3
+        return PyUnicode_FromString(date_string);
+#else
+        return PyString_FromString(date_string);
+#endif
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+/*
+ * Walk dict/list/tuple containers and return a copy with every datetime
+ * (and date if dates is set) replaced by its RFC3339 string. Other objects
+ * are returned as is.
+ */
+static PyObject *encode_datetimes_ex(PyObject *obj, int dates) {
+    PyObject *result = NULL;
+
+    if (PyDict_Check(obj)) {
+        PyObject *key, *value;
+        Py_ssize_t pos = 0;
+
+        if (Py_EnterRecursiveCall(" while encoding datetimes"))
+            return NULL;
+
+        result = PyDict_New();
+
+        while (result != NULL && PyDict_Next(obj, &pos, &key, &value)) {
+            PyObject *encoded = encode_datetimes_ex(value, dates);
+
+            if (encoded == NULL || PyDict_SetItem(result, key, encoded) < 0)
+                Py_CLEAR(result);
+
+            Py_XDECREF(encoded);
+        }
+
+        Py_LeaveRecursiveCall();
+        return result;
+    }
+
+    if (PyList_Check(obj) || PyTuple_Check(obj)) {
+        Py_ssize_t size = PySequence_Fast_GET_SIZE(obj);
+        PyObject **items = PySequence_Fast_ITEMS(obj);
+
+        if (Py_EnterRecursiveCall(" while encoding datetimes"))
+            return NULL;
+
+        result = PyList_Check(obj) ? PyList_New(size) : PyTuple_New(size);
+
+        for (Py_ssize_t i = 0; result != NULL && i < size; i++) {
+            PyObject *encoded = encode_datetimes_ex(items[i], dates);
+
+            if (encoded == NULL) {
+                Py_CLEAR(result);
+            } else if (PyList_Check(result)) {
+                PyList_SET_ITEM(result, i, encoded);
+            } else {
+                PyTuple_SET_ITEM(result, i, encoded);
+            }
+        }
+
+        Py_LeaveRecursiveCall();
+        return result;
+    }
+
+    result = datetime_or_date_to_string(obj, dates);
+
+    if (result == Py_None) {
+        Py_DECREF(result);
+        Py_INCREF(obj);
+        return obj;
+    }
+
+    return result;
+}
+
+static PyObject *encode_datetimes(PyObject *self, PyObject *args,
+                                  PyObject *kw) {
+    PyObject *obj = NULL;
+    int dates = 0;
+    static char *keywords[] = {"obj", "dates", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "O|i", keywords,
+                                     &obj, &dates))
+        return NULL;
+
+    STATS_ADD(STATS_ENCODE_DATETIMES, calls, 1);
+    return encode_datetimes_ex(obj, dates);
+}
+
+/*
+ * json.dumps(obj, default=json_default)
+ */
+static PyObject *json_default(PyObject *self, PyObject *obj) {
+    PyObject *result = datetime_or_date_to_string(obj, 1);
+
+    if (result == Py_None) {
+        Py_DECREF(result);
+        PyErr_Format(
+            PyExc_TypeError,
+            "Object of type %.200s is not JSON serializable",
+            Py_TYPE(obj)->tp_name
+        );
+        return NULL;
+    }
+
+    return result;
+}
+
+static PyObject *to_timestamp(PyObject *self, PyObject *args) {
+    PyObject *obj = NULL;
+
+    if (!PyArg_ParseTuple(args, "O", &obj))
+        return NULL;
+
+    STATS_ADD(STATS_TO_TIMESTAMP, calls, 1);
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    if (datetime_obj_to_dtstruct(obj, &dt) < 0)
+        return NULL;
+
+    return PyFloat_FromDouble(
+        (double)_date_time_to_timestamp_us(&dt) / 1000000.0
+    );
+}
+
+static PyObject *rfc3339_string_to_timestamp(PyObject *self, PyObject *args) {
+    char *rfc3339_string;
+
+    if (!PyArg_ParseTuple(args, "s", &rfc3339_string))
+        return NULL;
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    _parse_date_time(rfc3339_string, &dt);
+    STATS_ADD(STATS_STRING_TO_TIMESTAMP, calls, 1);
+    STATS_PARSED(STATS_STRING_TO_TIMESTAMP, dt, rfc3339_string);
+
+    check_date_time_struct(&dt);
+    if(PyErr_Occurred())
+        return NULL;
+
+    return PyFloat_FromDouble(
+        (double)_date_time_to_timestamp_us(&dt) / 1000000.0
+    );
+}
+
+static PyObject *rfc3339_string_to_timestamp_us(PyObject *self,
+                                                PyObject *args) {
+    char *rfc3339_string;
+
+    if (!PyArg_ParseTuple(args, "s", &rfc3339_string))
+        return NULL;
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    _parse_date_time(rfc3339_string, &dt);
+    STATS_ADD(STATS_STRING_TO_TIMESTAMP, calls, 1);
+    STATS_PARSED(STATS_STRING_TO_TIMESTAMP, dt, rfc3339_string);
+
+    check_date_time_struct(&dt);
+    if(PyErr_Occurred())
+        return NULL;
+
+    return PyLong_FromLongLong(_date_time_to_timestamp_us(&dt));
+}
+
+static PyObject *from_timestamp(PyObject *self, PyObject *args, PyObject *kw) {
+    double timestamp;
+    PyObject *tz = Py_None;
+    int compact = 0;
+    static char *keywords[] = {"timestamp", "tz", "compact", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "d|Oi",
+                                     keywords, &timestamp, &tz, &compact))
+        return NULL;
+
+    STATS_ADD(STATS_FROM_TIMESTAMP, calls, 1);
+
+    check_timestamp_platform_support(timestamp);
+    if(PyErr_Occurred())
+        return NULL;
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+
+    // TODO: Support all tzinfo subclasses by calling utcoffset()
+    if (tz && tz != Py_None) {
+        if (Py_TYPE(tz) != &FixedOffset_type) {
+            PyErr_Format(PyExc_TypeError, "tz must be of type TZFixedOffset.");
+            return NULL;
+        } else {
+            // Call gmtime based timestamp to datetime convertsion, offset provided
+            _timestamp_to_date_time(
+                timestamp, &dt, ((FixedOffset *)tz)->offset
+            );
+        }
+    } else if (compact) {
+        // UDateTime keeps the instant, give it the local UTC offset
+        _timestamp_to_date_time(timestamp, &dt, _get_local_utc_offset());
+    } else {
+        // Call localtime based timestamp to datetime convertsion, no offset
+        // provided, account for daylight saving
+        _local_timestamp_to_date_time(timestamp, &dt);
+    }
+
+    check_date_time_struct(&dt);
+    if(PyErr_Occurred())
+        return NULL;
+
+    if (compact)
+        return dtstruct_to_udatetime(&dt);
+
+    return dtstruct_to_datetime_obj(&dt);
+}
+
+static PyObject *from_utctimestamp(PyObject *self, PyObject *args) {
+    double timestamp;
+
+    if (!PyArg_ParseTuple(args, "d", &timestamp))
+        return NULL;
+
+    STATS_ADD(STATS_FROM_UTCTIMESTAMP, calls, 1);
+
+    check_timestamp_platform_support(timestamp);
+    if(PyErr_Occurred())
+        return NULL;
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    _timestamp_to_date_time(timestamp, &dt, 0);
+
+    check_date_time_struct(&dt);
+    if(PyErr_Occurred())
+        return NULL;
+
+    return dtstruct_to_datetime_obj(&dt);
+}
+
+static PyObject *utcnow_to_string(PyObject *self) {
+    char datetime_string[33] = {0};
+
+    STATS_ADD(STATS_UTCNOW_TO_STRING, calls, 1);
+    STATS_ADD(STATS_UTCNOW_TO_STRING, bytes, DATE_TIME_STRING_SIZE);
+
+    if (_coarse_clock_read(NULL, NULL, datetime_string, NULL)) {
+        STATS_ADD(STATS_UTCNOW_TO_STRING, fast_path, 1);
+    } else {
+        STATS_ADD(STATS_UTCNOW_TO_STRING, fallback, 1);
+        date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+        _utcnow(&dt);
+        _format_date_time(&dt, datetime_string);
+    }
+
+#ifdef _PYTHON3
+    return PyUnicode_FromString(datetime_string);
+#else
+    return PyString_FromString(datetime_string);
+#endif
+}
+
+static PyObject *localnow_to_string(PyObject *self) {
+    char datetime_string[33] = {0};
+
+    STATS_ADD(STATS_NOW_TO_STRING, calls, 1);
+    STATS_ADD(STATS_NOW_TO_STRING, bytes, DATE_TIME_STRING_SIZE);
+
+    if (_coarse_clock_read(NULL, NULL, NULL, datetime_string)) {
+        STATS_ADD(STATS_NOW_TO_STRING, fast_path, 1);
+    } else {
+        STATS_ADD(STATS_NOW_TO_STRING, fallback, 1);
+        date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+        _localnow(&dt);
+        _format_date_time(&dt, datetime_string);
+    }
+
+#ifdef _PYTHON3
+    return PyUnicode_FromString(datetime_string);
+#else
+    return PyString_FromString(datetime_string);
+#endif
+}
+
+/*
+ * def to_http_date(value):
+ * datetime, UDateTime or POSIX timestamp -> HTTP-date string
+ */
+static PyObject *to_http_date(PyObject *self, PyObject *value) {
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    char http_date_string[HTTP_DATE_SIZE + 1] = {0};
+    long long timestamp_us;
+
+    STATS_ADD(STATS_TO_HTTP_DATE, calls, 1);
+
+    if (PyDateTime_Check(value) || Py_TYPE(value) == &UDateTime_type) {
+        if (datetime_obj_to_dtstruct(value, &dt) != 0)
+            return NULL;
+
+        timestamp_us = _date_time_to_timestamp_us(&dt);
+    } else {
+        double timestamp = PyFloat_AsDouble(value);
+
+        if (timestamp == -1.0 && PyErr_Occurred())
+            return NULL;
+
+        if (!(timestamp >= MIN_TIMESTAMP_US / 1e6 &&
+              timestamp <= MAX_TIMESTAMP_US / 1e6)) {
+            PyErr_SetString(PyExc_ValueError, "date value out of range");
+            return NULL;
+        }
+
+        timestamp_us = (long long)floor(timestamp) * SEC_IN_USECS;
+    }
+
+    _timestamp_us_to_date_time(timestamp_us, &dt, 0);
+
+    if (dt.date.year < 1 || dt.date.year > 9999) {
+        PyErr_SetString(PyExc_ValueError, "date value out of range");
+        return NULL;
+    }
+
+    _format_http_date(&dt, http_date_string);
+    STATS_ADD(STATS_TO_HTTP_DATE, bytes, HTTP_DATE_SIZE);
+
+#ifdef _PYTHON3
+    return PyUnicode_FromStringAndSize(http_date_string, HTTP_DATE_SIZE);
+#else
+    return PyString_FromStringAndSize(http_date_string, HTTP_DATE_SIZE);
+#endif
+}
+
+static PyObject *utcnow_to_http_date(PyObject *self) {
+    char http_date_string[HTTP_DATE_SIZE + 1] = {0};
+
+    _http_date_now(http_date_string);
+    STATS_ADD(STATS_UTCNOW_TO_HTTP_DATE, calls, 1);
+    STATS_ADD(STATS_UTCNOW_TO_HTTP_DATE, bytes, HTTP_DATE_SIZE);
+
+#ifdef _PYTHON3
+    return PyUnicode_FromStringAndSize(http_date_string, HTTP_DATE_SIZE);
+#else
+    return PyString_FromStringAndSize(http_date_string, HTTP_DATE_SIZE);
+#endif
+}
+
+static PyObject *from_http_date(PyObject *self, PyObject *args) {
+    char *http_date_string;
     date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
-    _localnow(&dt);
+
+    if (!PyArg_ParseTuple(args, "s", &http_date_string))
+        return NULL;
+
+    _parse_http_date(http_date_string, &dt);
+    STATS_ADD(STATS_FROM_HTTP_DATE, calls, 1);
+    STATS_PARSED(STATS_FROM_HTTP_DATE, dt, http_date_string);
+
+    if (dt.ok != 1) {
+        PyErr_SetString(
+            PyExc_ValueError,
+            dt.date.ok != 1 ? "Invalid HTTP-date string. Date invalid."
+                            : "Invalid HTTP-date string. Time invalid."
+        );
+        return NULL;
+    }
+
     return dtstruct_to_datetime_obj(&dt);
 }
 
-static PyObject *from_rfc3339_string(PyObject *self, PyObject *args) {
+static PyObject *floor_timestamps_us(PyObject *self, PyObject *args,
+                                     PyObject *kw) {
+    PyObject *values_obj = NULL;
+    PyObject *out_obj = NULL;
+    char *unit_string;
+    int offset = 0;
+    int unit;
+    static char *keywords[] = {"values", "out", "unit", "offset", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OOs|i", keywords,
+                                     &values_obj, &out_obj, &unit_string,
+                                     &offset))
+        return NULL;
+
+    STATS_ADD(STATS_FLOOR_TIMESTAMPS_US, calls, 1);
+
+    if (strcmp(unit_string, "second") == 0) {
+        unit = UNIT_SECOND;
+    } else if (strcmp(unit_string, "minute") == 0) {
+        unit = UNIT_MINUTE;
+    } else if (strcmp(unit_string, "hour") == 0) {
+        unit = UNIT_HOUR;
+    } else if (strcmp(unit_string, "day") == 0) {
+        unit = UNIT_DAY;
+    } else if (strcmp(unit_string, "week") == 0) {
+        unit = UNIT_WEEK;
+    } else if (strcmp(unit_string, "month") == 0) {
+        unit = UNIT_MONTH;
+    } else if (strcmp(unit_string, "year") == 0) {
+        unit = UNIT_YEAR;
+    } else {
+        PyErr_Format(PyExc_ValueError, "Invalid unit '%s'.", unit_string);
+        return NULL;
+    }
+
+    if (offset <= -24 * HOUR_IN_MINS || offset >= 24 * HOUR_IN_MINS) {
+        PyErr_SetString(PyExc_ValueError, "offset must be -1439 - 1439.");
+        return NULL;
+    }
+
+    Py_buffer values, out;
+
+    if (get_int64_buffer(values_obj, &values, 0) < 0)
+        return NULL;
+
+    if (get_int64_buffer(out_obj, &out, 1) < 0) {
+        PyBuffer_Release(&values);
+        return NULL;
+    }
+
+    if (out.len < values.len) {
+        PyBuffer_Release(&values);
+        PyBuffer_Release(&out);
+        PyErr_SetString(PyExc_ValueError, "out is smaller than values.");
+        return NULL;
+    }
+
+    const long long *in_ptr = (const long long *)values.buf;
+    long long *out_ptr = (long long *)out.buf;
+    Py_ssize_t count = values.len / 8;
+    Py_ssize_t i;
+
+    STATS_ADD(STATS_FLOOR_TIMESTAMPS_US, bytes, values.len);
+
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < count; i++) {
+        // keep the int64 arithmetic of _floor_timestamp_us from overflowing
+        if (in_ptr[i] < MIN_TIMESTAMP_US || in_ptr[i] > MAX_TIMESTAMP_US)
+            break;
+
+        out_ptr[i] = _floor_timestamp_us(in_ptr[i], unit, offset);
+    }
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&values);
+    PyBuffer_Release(&out);
+
+    if (i < count) {
+        PyErr_Format(
+            PyExc_OverflowError, "timestamp out of range at index %zd.", i
+        );
+        return NULL;
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *normalize_many(PyObject *self, PyObject *args,
+                                PyObject *kw) {
+    PyObject *strings = NULL;
+    unsigned int precision = 6;
+    static char *keywords[] = {"strings", "precision", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "O|I", keywords,
+                                     &strings, &precision))
+        return NULL;
+
+    if (precision > 6) {
+        PyErr_SetString(PyExc_ValueError, "precision must be 0 - 6.");
+        return NULL;
+    }
+
+    STATS_ADD(STATS_NORMALIZE_MANY, calls, 1);
+
+    PyObject *seq = PySequence_Fast(strings, "Expected a sequence.");
+    if (seq == NULL)
+        return NULL;
+
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    PyObject *result = PyList_New(count);
+
+    if (result == NULL) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        const char *rfc3339_string = get_rfc3339_string(items[i]);
+        if (rfc3339_string == NULL)
+            goto error;
+
+        date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+        _parse_date_time((char *)rfc3339_string, &dt);
+        STATS_PARSED(STATS_NORMALIZE_MANY, dt, rfc3339_string);
+
+        check_date_time_struct(&dt);
+        if(PyErr_Occurred())
+            goto error;
+
+        if (dt.time.offset != 0) {
+            _timestamp_us_to_date_time(
+                _date_time_to_timestamp_us(&dt), &dt, 0
+            );
+
+            if (dt.date.year < 1 || dt.date.year > 9999) {
+                PyErr_SetString(
+                    PyExc_ValueError, "date-time out of range in UTC."
+                );
+                goto error;
+            }
+        }
+
+        char datetime_string[28] = {0};
+        _format_date_time_utc(&dt, datetime_string, precision);
+
+#ifdef _PYTHON3
+        PyObject *normalized = PyUnicode_FromString(datetime_string);
+#else
+        PyObject *normalized = PyString_FromString(datetime_string);
+#endif
+        if (normalized == NULL)
+            goto error;
+
+        PyList_SET_ITEM(result, i, normalized);
+    }
+
+    Py_DECREF(seq);
+    return result;
+
+error:
+    Py_DECREF(seq);
+    Py_DECREF(result);
+    return NULL;
+}
+
+static PyObject *is_valid(PyObject *self, PyObject *args) {
     char *rfc3339_string;
 
     if (!PyArg_ParseTuple(args, "s", &rfc3339_string))
@@ -765,157 +2976,699 @@ static PyObject *from_rfc3339_string(PyObject *self, PyObject *args) {
 
     date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
     _parse_date_time(rfc3339_string, &dt);
+    STATS_ADD(STATS_IS_VALID, calls, 1);
+    STATS_PARSED(STATS_IS_VALID, dt, rfc3339_string);
 
-    check_date_time_struct(&dt);
-    if(PyErr_Occurred())
+    return PyBool_FromLong(dt.ok == 1);
+}
+
+static PyObject *validate_many(PyObject *self, PyObject *args, PyObject *kw) {
+    PyObject *strings = NULL;
+    PyObject *out_obj = Py_None;
+    static char *keywords[] = {"strings", "out", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "O|O", keywords,
+                                     &strings, &out_obj))
         return NULL;
 
-    return dtstruct_to_datetime_obj(&dt);
+    STATS_ADD(STATS_VALIDATE_MANY, calls, 1);
+
+    PyObject *seq = PySequence_Fast(strings, "Expected a sequence.");
+    if (seq == NULL)
+        return NULL;
+
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    PyObject *result = NULL;
+    Py_buffer out;
+
+    if (out_obj == Py_None) {
+        result = PyByteArray_FromStringAndSize(NULL, count);
+        if (result == NULL) {
+            Py_DECREF(seq);
+            return NULL;
+        }
+        out_obj = result;
+    } else {
+        Py_INCREF(out_obj);
+        result = out_obj;
+    }
+
+    if (PyObject_GetBuffer(out_obj, &out, PyBUF_C_CONTIGUOUS |\
+                           PyBUF_WRITABLE) < 0) {
+        Py_DECREF(seq);
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    if (out.len < count) {
+        PyBuffer_Release(&out);
+        Py_DECREF(seq);
+        Py_DECREF(result);
+        PyErr_SetString(PyExc_ValueError, "out is smaller than strings.");
+        return NULL;
+    }
+
+    char *out_ptr = (char *)out.buf;
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        const char *rfc3339_string = NULL;
+        Py_ssize_t length = 0;
+
+#ifdef _PYTHON3
+        if (PyUnicode_Check(items[i]))
+            rfc3339_string = PyUnicode_AsUTF8AndSize(items[i], &length);
+#else
+        if (PyString_Check(items[i]))
+            PyString_AsStringAndSize(items[i], (char **)&rfc3339_string,
+                                     &length);
+#endif
+        // non-string, unencodable or NUL containing items are invalid
+        if (rfc3339_string == NULL ||
+                strlen(rfc3339_string) != (size_t)length) {
+            PyErr_Clear();
+            out_ptr[i] = 0;
+            continue;
+        }
+
+        date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+        _parse_date_time((char *)rfc3339_string, &dt);
+        STATS_PARSED(STATS_VALIDATE_MANY, dt, rfc3339_string);
+        out_ptr[i] = dt.ok == 1;
+    }
+
+    PyBuffer_Release(&out);
+    Py_DECREF(seq);
+    return result;
 }
 
-static PyObject *to_rfc3339_string(PyObject *self, PyObject *args) {
+/*
+ * def diff_us(a, b):
+ * Signed microseconds a - b of two RFC3339 strings, no datetime objects
+ */
+static PyObject *diff_us(PyObject *self, PyObject *args) {
+    char *a_string, *b_string;
+
+    if (!PyArg_ParseTuple(args, "ss", &a_string, &b_string))
+        return NULL;
+
+    STATS_ADD(STATS_DIFF_US, calls, 1);
+
+    date_time_struct a = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    date_time_struct b = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+
+    _parse_date_time(a_string, &a);
+    STATS_PARSED(STATS_DIFF_US, a, a_string);
+
+    check_date_time_struct(&a);
+    if (PyErr_Occurred())
+        return NULL;
+
+    _parse_date_time(b_string, &b);
+    STATS_PARSED(STATS_DIFF_US, b, b_string);
+
+    check_date_time_struct(&b);
+    if (PyErr_Occurred())
+        return NULL;
+
+    return PyLong_FromLongLong(_date_time_diff_us(&a, &b));
+}
+
+/*
+ * Parse item i of a PySequence_Fast of RFC3339 strings. Sets a Python
+ * exception naming the index and returns -1 on error.
+ */
+static int parse_sequence_item(PyObject **items, Py_ssize_t i,
+                               date_time_struct *dt, int stats_entry) {
+    const char *rfc3339_string = NULL;
+    Py_ssize_t length = 0;
+
+#ifdef _PYTHON3
+    if (PyUnicode_Check(items[i]))
+        rfc3339_string = PyUnicode_AsUTF8AndSize(items[i], &length);
+#else
+    if (PyString_Check(items[i]))
+        PyString_AsStringAndSize(items[i], (char **)&rfc3339_string,
+                                 &length);
+#endif
+
+    if (rfc3339_string == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_Format(
+                PyExc_TypeError, "Expected a string at index %zd.", i
+            );
+        }
+        return -1;
+    }
+
+    _parse_date_time((char *)rfc3339_string, dt);
+    STATS_PARSED(stats_entry, (*dt), rfc3339_string);
+
+    // NUL containing strings are invalid
+    if ((*dt).ok != 1 || strlen(rfc3339_string) != (size_t)length) {
+        PyErr_Format(
+            PyExc_ValueError,
+            "Invalid RFC3339 date-time string at index %zd.", i
+        );
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * def diff_many(a_strings, b_strings, out):
+ * out[i] = diff_us(a_strings[i], b_strings[i]), out is an int64 buffer
+ */
+static PyObject *diff_many(PyObject *self, PyObject *args, PyObject *kw) {
+    PyObject *a_strings = NULL;
+    PyObject *b_strings = NULL;
+    PyObject *out_obj = NULL;
+    static char *keywords[] = {"a_strings", "b_strings", "out", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OOO", keywords,
+                                     &a_strings, &b_strings, &out_obj))
+        return NULL;
+
+    STATS_ADD(STATS_DIFF_MANY, calls, 1);
+
+    PyObject *a_seq = PySequence_Fast(a_strings, "Expected a sequence.");
+    if (a_seq == NULL)
+        return NULL;
+
+    PyObject *b_seq = PySequence_Fast(b_strings, "Expected a sequence.");
+    if (b_seq == NULL) {
+        Py_DECREF(a_seq);
+        return NULL;
+    }
+
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(a_seq);
+    Py_buffer out;
+
+    if (PySequence_Fast_GET_SIZE(b_seq) != count) {
+        Py_DECREF(a_seq);
+        Py_DECREF(b_seq);
+        PyErr_SetString(
+            PyExc_ValueError, "a_strings and b_strings differ in length."
+        );
+        return NULL;
+    }
+
+    if (get_int64_buffer(out_obj, &out, 1) < 0) {
+        Py_DECREF(a_seq);
+        Py_DECREF(b_seq);
+        return NULL;
+    }
+
+    if (out.len / 8 < count) {
+        PyBuffer_Release(&out);
+        Py_DECREF(a_seq);
+        Py_DECREF(b_seq);
+        PyErr_SetString(PyExc_ValueError, "out is smaller than a_strings.");
+        return NULL;
+    }
+
+    PyObject **a_items = PySequence_Fast_ITEMS(a_seq);
+    PyObject **b_items = PySequence_Fast_ITEMS(b_seq);
+    long long *out_ptr = (long long *)out.buf;
+    int status = 0;
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        date_time_struct a = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+        date_time_struct b = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+
+        if (parse_sequence_item(a_items, i, &a, STATS_DIFF_MANY) < 0 ||
+                parse_sequence_item(b_items, i, &b, STATS_DIFF_MANY) < 0) {
+            status = -1;
+            break;
+        }
+
+        out_ptr[i] = _date_time_diff_us(&a, &b);
+    }
+
+    PyBuffer_Release(&out);
+    Py_DECREF(a_seq);
+    Py_DECREF(b_seq);
+
+    if (status < 0)
+        return NULL;
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *enable_coarse_clock(PyObject *self, PyObject *args,
+                                     PyObject *kw) {
+    double resolution = 0.001;
+    static char *keywords[] = {"resolution", NULL};
+    int status;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "|d", keywords, &resolution))
+        return NULL;
+
+    // 0 ns would keep the ticker from ever sleeping
+    if (!(resolution >= 1e-9 && resolution <= 60.0)) {
+        PyErr_SetString(
+            PyExc_ValueError, "resolution must be >= 1 ns and <= 60 seconds."
+        );
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    status = _coarse_clock_start(
+        (long long)(resolution * 1000000000.0 + 0.5)
+    );
+    Py_END_ALLOW_THREADS
+
+    if (status != 0) {
+        PyErr_SetString(PyExc_RuntimeError, "Can't start coarse clock thread.");
+        return NULL;
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *disable_coarse_clock(PyObject *self) {
+    Py_BEGIN_ALLOW_THREADS
+    _coarse_clock_stop();
+    Py_END_ALLOW_THREADS
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *to_bytes(PyObject *self, PyObject *args) {
     PyObject *obj = NULL;
 
     if (!PyArg_ParseTuple(args, "O", &obj))
         return NULL;
 
-    if (!PyDateTime_Check(obj)) {
-        PyErr_SetString(PyExc_ValueError, "Expected a datetime object.");
+    STATS_ADD(STATS_TO_BYTES, calls, 1);
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    if (datetime_obj_to_dtstruct(obj, &dt) < 0)
+        return NULL;
+
+    unsigned char packed[PACKED_DATE_TIME_SIZE];
+    _pack_date_time(&dt, packed);
+    STATS_ADD(STATS_TO_BYTES, bytes, PACKED_DATE_TIME_SIZE);
+
+    return PyBytes_FromStringAndSize((char *)packed, PACKED_DATE_TIME_SIZE);
+}
+
+static PyObject *from_bytes(PyObject *self, PyObject *args) {
+    Py_buffer packed;
+
+#ifdef _PYTHON3
+    if (!PyArg_ParseTuple(args, "y*", &packed))
+#else
+    if (!PyArg_ParseTuple(args, "s*", &packed))
+#endif
+        return NULL;
+
+    STATS_ADD(STATS_FROM_BYTES, calls, 1);
+    STATS_ADD(STATS_FROM_BYTES, bytes, packed.len);
+
+    if (packed.len != PACKED_DATE_TIME_SIZE) {
+        PyBuffer_Release(&packed);
+        PyErr_Format(
+            PyExc_ValueError, "Expected %d bytes.", PACKED_DATE_TIME_SIZE
+        );
+        return NULL;
+    }
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    _unpack_date_time((unsigned char *)packed.buf, &dt);
+    PyBuffer_Release(&packed);
+    STATS_INVALID(STATS_FROM_BYTES, dt);
+
+    check_packed_date_time(&dt);
+    if(PyErr_Occurred())
+        return NULL;
+
+    return dtstruct_to_datetime_obj(&dt);
+}
+
+static PyObject *to_bytes_many(PyObject *self, PyObject *args) {
+    PyObject *datetimes = NULL;
+
+    if (!PyArg_ParseTuple(args, "O", &datetimes))
+        return NULL;
+
+    STATS_ADD(STATS_TO_BYTES_MANY, calls, 1);
+
+    PyObject *seq = PySequence_Fast(datetimes, "Expected a sequence.");
+    if (seq == NULL)
+        return NULL;
+
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    PyObject *result = PyBytes_FromStringAndSize(
+        NULL, count * PACKED_DATE_TIME_SIZE
+    );
+
+    if (result == NULL) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+
+    unsigned char *packed = (unsigned char *)PyBytes_AS_STRING(result);
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+
+        if (datetime_obj_to_dtstruct(items[i], &dt) < 0) {
+            Py_DECREF(seq);
+            Py_DECREF(result);
+            return NULL;
+        }
+
+        _pack_date_time(&dt, packed + i * PACKED_DATE_TIME_SIZE);
+    }
+
+    STATS_ADD(STATS_TO_BYTES_MANY, bytes, count * PACKED_DATE_TIME_SIZE);
+    Py_DECREF(seq);
+    return result;
+}
+
+static PyObject *from_bytes_many(PyObject *self, PyObject *args) {
+    Py_buffer packed;
+
+#ifdef _PYTHON3
+    if (!PyArg_ParseTuple(args, "y*", &packed))
+#else
+    if (!PyArg_ParseTuple(args, "s*", &packed))
+#endif
+        return NULL;
+
+    STATS_ADD(STATS_FROM_BYTES_MANY, calls, 1);
+    STATS_ADD(STATS_FROM_BYTES_MANY, bytes, packed.len);
+
+    if (packed.len % PACKED_DATE_TIME_SIZE != 0) {
+        PyBuffer_Release(&packed);
+        PyErr_Format(
+            PyExc_ValueError, "Expected a multiple of %d bytes.",
+            PACKED_DATE_TIME_SIZE
+        );
+        return NULL;
+    }
+
+    Py_ssize_t count = packed.len / PACKED_DATE_TIME_SIZE;
+    PyObject *result = PyList_New(count);
+
+    if (result == NULL) {
+        PyBuffer_Release(&packed);
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+        _unpack_date_time(
+            (unsigned char *)packed.buf + i * PACKED_DATE_TIME_SIZE, &dt
+        );
+        STATS_INVALID(STATS_FROM_BYTES_MANY, dt);
+
+        check_packed_date_time(&dt);
+        PyObject *datetime_obj = PyErr_Occurred() ?\
+            NULL : dtstruct_to_datetime_obj(&dt);
+
+        if (datetime_obj == NULL) {
+            PyBuffer_Release(&packed);
+            Py_DECREF(result);
+            return NULL;
+        }
+
+        PyList_SET_ITEM(result, i, datetime_obj);
+    }
+
+    PyBuffer_Release(&packed);
+    return result;
+}
+
+/*
+ * Format int64 timestamp item i of values (microseconds, or nanoseconds if
+ * ns is set) in offset to datetime_string. Returns -1 if out of range.
+ */
+static int format_timestamp_item(const long long *values, Py_ssize_t i,
+                                 int ns, int offset, char *datetime_string) {
+    long long timestamp_us = ns ?\
+        _floor_div(values[i], 1000) : values[i];
+
+    if (timestamp_us < MIN_TIMESTAMP_US || timestamp_us > MAX_TIMESTAMP_US)
+        return -1;
+
+    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+    _timestamp_us_to_date_time(timestamp_us, &dt, offset);
+
+    if (dt.date.year < 1 || dt.date.year > 9999)
+        return -1;
+
+    _format_date_time(&dt, datetime_string);
+    return 0;
+}
+
+static PyObject *timestamps_to_rfc3339_strings(PyObject *self,
+                                               PyObject *args,
+                                               PyObject *kw) {
+    PyObject *values_obj = NULL;
+    int offset = 0;
+    char *unit = "us";
+    int packed = 0;
+    static char *keywords[] = {"values", "offset", "unit", "packed", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "O|isi", keywords,
+                                     &values_obj, &offset, &unit, &packed))
+        return NULL;
+
+    STATS_ADD(STATS_TIMESTAMPS_TO_STRINGS, calls, 1);
+
+    if (strcmp(unit, "us") != 0 && strcmp(unit, "ns") != 0) {
+        PyErr_SetString(PyExc_ValueError, "unit must be 'us' or 'ns'.");
         return NULL;
     }
 
-    PyDateTime_DateTime *datetime_obj = (PyDateTime_DateTime *)obj;
-    int offset = 0;
+    if (offset <= -24 * HOUR_IN_MINS || offset >= 24 * HOUR_IN_MINS) {
+        PyErr_SetString(PyExc_ValueError, "offset must be within +/-23:59.");
+        return NULL;
+    }
+
+    Py_buffer values;
+
+    if (get_int64_buffer(values_obj, &values, 0) < 0)
+        return NULL;
+
+    const long long *values_ptr = (const long long *)values.buf;
+    Py_ssize_t count = values.len / 8;
+    int ns = unit[0] == 'n';
+    PyObject *result = NULL;
+    Py_ssize_t failed = -1;
+
+    STATS_ADD(STATS_TIMESTAMPS_TO_STRINGS, bytes, values.len);
+
+    if (packed) {
+        result = PyBytes_FromStringAndSize(NULL, count * DATE_TIME_STRING_SIZE);
+        if (result == NULL)
+            goto cleanup;
+
+        char *out = PyBytes_AS_STRING(result);
+
+        Py_BEGIN_ALLOW_THREADS
+        for (Py_ssize_t i = 0; i < count; i++) {
+            char datetime_string[33] = {0};
+
+            if (format_timestamp_item(values_ptr, i, ns, offset,
+                                      datetime_string) < 0) {
+                failed = i;
+                break;
+            }
 
-    // TODO: Support all tzinfo subclasses by calling utcoffset()
-    if (datetime_obj->hastzinfo) {
-        if (Py_TYPE(datetime_obj->tzinfo) == &FixedOffset_type) {
-            FixedOffset *tzinfo = (FixedOffset *)datetime_obj->tzinfo;
-            offset = tzinfo->offset;
-        } else {
-            PyErr_SetString(PyExc_ValueError, "Only TZFixedOffset supported.");
-            return NULL;
+            memcpy(out + i * DATE_TIME_STRING_SIZE, datetime_string,
+                   DATE_TIME_STRING_SIZE);
         }
-    }
+        Py_END_ALLOW_THREADS
+    } else {
+        result = PyList_New(count);
+        if (result == NULL)
+            goto cleanup;
 
-    date_time_struct dt = {
-        {
-            (datetime_obj->data[0] << 8) | datetime_obj->data[1],
-            datetime_obj->data[2],
-            datetime_obj->data[3],
-            0, // wday, not needed
-            1
-        },
-        {
-            datetime_obj->data[4],
-            datetime_obj->data[5],
-            datetime_obj->data[6],
-            (
-                (datetime_obj->data[7] << 16) |\
-                (datetime_obj->data[8] << 8) |\
-                datetime_obj->data[9]
-            ),
-            offset,
-            1
-        },
-        1
-    };
+        for (Py_ssize_t i = 0; i < count; i++) {
+            char datetime_string[33] = {0};
 
-    char datetime_string[33] = {0};
-    _format_date_time(&dt, datetime_string);
+            if (format_timestamp_item(values_ptr, i, ns, offset,
+                                      datetime_string) < 0) {
+                failed = i;
+                break;
+            }
 
 #ifdef _PYTHON3
-    return PyUnicode_FromString(datetime_string);
+            PyObject *item = PyUnicode_FromString(datetime_string);
 #else
-    return PyString_FromString(datetime_string);
+            PyObject *item = PyString_FromString(datetime_string);
 #endif
-}
+            if (item == NULL) {
+                Py_CLEAR(result);
+                goto cleanup;
+            }
 
-static PyObject *from_timestamp(PyObject *self, PyObject *args, PyObject *kw) {
-    double timestamp;
-    PyObject *tz = Py_None;
-    static char *keywords[] = {"timestamp", "tz", NULL};
+            PyList_SET_ITEM(result, i, item);
+        }
+    }
 
-    if (!PyArg_ParseTupleAndKeywords(args, kw, "d|O",
-                                     keywords, &timestamp, &tz))
-        return NULL;
+    if (failed >= 0) {
+        Py_CLEAR(result);
+        PyErr_Format(
+            PyExc_ValueError,
+            "timestamp at index %zd out of range for RFC3339.", failed
+        );
+    }
 
-    check_timestamp_platform_support(timestamp);
-    if(PyErr_Occurred())
+cleanup:
+    PyBuffer_Release(&values);
+    return result;
+}
+
+static PyObject *get_stats(PyObject *self) {
+    PyObject *result = PyDict_New();
+
+    if (result == NULL)
         return NULL;
 
-    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+#ifdef UDATETIME_STATS
+    for (int i = 0; i < STATS_ENTRIES; i++) {
+        PyObject *entry = Py_BuildValue(
+            "{s:K,s:K,s:K,s:K,s:K,s:K}",
+            "calls",
+            __atomic_load_n(&(stats[i].calls), __ATOMIC_RELAXED),
+            "date_invalid",
+            __atomic_load_n(&(stats[i].date_invalid), __ATOMIC_RELAXED),
+            "time_invalid",
+            __atomic_load_n(&(stats[i].time_invalid), __ATOMIC_RELAXED),
+            "fast_path",
+            __atomic_load_n(&(stats[i].fast_path), __ATOMIC_RELAXED),
+            "fallback",
+            __atomic_load_n(&(stats[i].fallback), __ATOMIC_RELAXED),
+            "bytes",
+            __atomic_load_n(&(stats[i].bytes), __ATOMIC_RELAXED)
+        );
 
-    // TODO: Support all tzinfo subclasses by calling utcoffset()
-    if (tz && tz != Py_None) {
-        if (Py_TYPE(tz) != &FixedOffset_type) {
-            PyErr_Format(PyExc_TypeError, "tz must be of type TZFixedOffset.");
+        if (entry == NULL ||
+                PyDict_SetItemString(result, stats_names[i], entry) < 0) {
+            Py_XDECREF(entry);
+            Py_DECREF(result);
             return NULL;
-        } else {
-            // Call gmtime based timestamp to datetime convertsion, offset provided
-            _timestamp_to_date_time(
-                timestamp, &dt, ((FixedOffset *)tz)->offset
-            );
         }
-    } else {
-        // Call localtime based timestamp to datetime convertsion, no offset
-        // provided, account for daylight saving
-        _local_timestamp_to_date_time(timestamp, &dt);
+
+        Py_DECREF(entry);
     }
+#endif
 
-    check_date_time_struct(&dt);
-    if(PyErr_Occurred())
-        return NULL;
+    return result;
+}
 
-    return dtstruct_to_datetime_obj(&dt);
+static PyObject *reset_stats(PyObject *self) {
+#ifdef UDATETIME_STATS
+    for (int i = 0; i < STATS_ENTRIES; i++) {
+        __atomic_store_n(&(stats[i].calls), 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&(stats[i].date_invalid), 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&(stats[i].time_invalid), 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&(stats[i].fast_path), 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&(stats[i].fallback), 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&(stats[i].bytes), 0, __ATOMIC_RELAXED);
+    }
+#endif
+
+    Py_INCREF(Py_None);
+    return Py_None;
 }
 
-static PyObject *from_utctimestamp(PyObject *self, PyObject *args) {
-    double timestamp;
+static PyObject *rfc3339_strings_to_components(PyObject *self,
+                                               PyObject *args,
+                                               PyObject *kw) {
+    PyObject *strings = NULL;
+    PyObject *columns[9] = {NULL};
+    Py_buffer views[9];
+    int used[9] = {0};
+    static char *keywords[] = {
+        "strings", "year", "month", "day", "hour", "minute", "second",
+        "usec", "offset", "wday", NULL
+    };
 
-    if (!PyArg_ParseTuple(args, "d", &timestamp))
+    if (!PyArg_ParseTupleAndKeywords(
+            args, kw, "O|OOOOOOOOO", keywords, &strings, &columns[0],
+            &columns[1], &columns[2], &columns[3], &columns[4], &columns[5],
+            &columns[6], &columns[7], &columns[8]))
         return NULL;
 
-    check_timestamp_platform_support(timestamp);
-    if(PyErr_Occurred())
+    STATS_ADD(STATS_STRINGS_TO_COMPONENTS, calls, 1);
+
+    PyObject *seq = PySequence_Fast(strings, "Expected a sequence.");
+    if (seq == NULL)
         return NULL;
 
-    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
-    _timestamp_to_date_time(timestamp, &dt, 0);
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    PyObject *result = NULL;
 
-    check_date_time_struct(&dt);
-    if(PyErr_Occurred())
-        return NULL;
+    for (int c = 0; c < 9; c++) {
+        if (columns[c] == NULL || columns[c] == Py_None)
+            continue;
 
-    return dtstruct_to_datetime_obj(&dt);
-}
+        if (get_int_buffer(columns[c], &views[c]) < 0)
+            goto cleanup;
 
-static PyObject *utcnow_to_string(PyObject *self) {
-    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
-    _utcnow(&dt);
+        used[c] = 1;
 
-    char datetime_string[33] = {0};
-    _format_date_time(&dt, datetime_string);
+        if (views[c].len / views[c].itemsize < count) {
+            PyErr_Format(
+                PyExc_ValueError, "%s is smaller than strings.",
+                keywords[c + 1]
+            );
+            goto cleanup;
+        }
+    }
 
-#ifdef _PYTHON3
-    return PyUnicode_FromString(datetime_string);
-#else
-    return PyString_FromString(datetime_string);
-#endif
-}
+    for (Py_ssize_t i = 0; i < count; i++) {
+        const char *rfc3339_string = get_rfc3339_string(items[i]);
+        if (rfc3339_string == NULL)
+            goto cleanup;
 
-static PyObject *localnow_to_string(PyObject *self) {
-    date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
-    _localnow(&dt);
+        date_time_struct dt = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0}, 0};
+        _parse_date_time((char *)rfc3339_string, &dt);
+        STATS_PARSED(STATS_STRINGS_TO_COMPONENTS, dt, rfc3339_string);
 
-    char datetime_string[33] = {0};
-    _format_date_time(&dt, datetime_string);
+        check_date_time_struct(&dt);
+        if(PyErr_Occurred())
+            goto cleanup;
 
-#ifdef _PYTHON3
-    return PyUnicode_FromString(datetime_string);
-#else
-    return PyString_FromString(datetime_string);
-#endif
+        long long values[9] = {
+            dt.date.year, dt.date.month, dt.date.day,
+            dt.time.hour, dt.time.minute, dt.time.second,
+            dt.time.fraction, dt.time.offset, dt.date.wday
+        };
+
+        for (int c = 0; c < 9; c++) {
+            if (!used[c])
+                continue;
+
+            if (views[c].itemsize == 4) {
+                ((int *)views[c].buf)[i] = (int)values[c];
+            } else {
+                ((long long *)views[c].buf)[i] = values[c];
+            }
+        }
+    }
+
+    result = PyLong_FromSsize_t(count);
+
+cleanup:
+    for (int c = 0; c < 9; c++) {
+        if (used[c])
+            PyBuffer_Release(&views[c]);
+    }
+
+    Py_DECREF(seq);
+    return result;
 }
 
 // static PyObject *bench_c(PyObject *self) {
@@ -941,7 +3694,10 @@ static PyMethodDef rfc3339_methods[] = {
         "from_timestamp",
         (PyCFunction) from_timestamp,
         METH_VARARGS | METH_KEYWORDS,
-        PyDoc_STR("timestamp[, tz] -> tz's local time from POSIX timestamp.")
+        PyDoc_STR(
+            "timestamp[, tz, compact] -> tz's local time from POSIX "
+            "timestamp, UDateTime if compact is true."
+        )
     },
     {
         "from_utctimestamp",
@@ -954,8 +3710,20 @@ static PyMethodDef rfc3339_methods[] = {
     {
         "from_rfc3339_string",
         (PyCFunction) from_rfc3339_string,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "rfc3339_string[, compact] -> parse RFC3339 compliant date-time "
+            "string to datetime, or UDateTime if compact is true."
+        )
+    },
+    {
+        "from_rfc3339_string_tuple",
+        (PyCFunction) from_rfc3339_string_tuple,
         METH_VARARGS,
-        PyDoc_STR("Parse RFC3339 compliant date-time string.")
+        PyDoc_STR(
+            "Parse RFC3339 date-time string to DateTimeTuple "
+            "(year, month, day, hour, minute, second, usec, offset, wday)."
+        )
     },
     {
         "to_rfc3339_string",
@@ -963,18 +3731,231 @@ static PyMethodDef rfc3339_methods[] = {
         METH_VARARGS,
         PyDoc_STR("Serialize datetime to RFC3339 compliant date-time string.")
     },
+    {
+        "to_timestamp",
+        (PyCFunction) to_timestamp,
+        METH_VARARGS,
+        PyDoc_STR("datetime -> POSIX timestamp, without timegm() or mktime().")
+    },
+    {
+        "rfc3339_string_to_timestamp",
+        (PyCFunction) rfc3339_string_to_timestamp,
+        METH_VARARGS,
+        PyDoc_STR("Parse RFC3339 date-time string to POSIX timestamp.")
+    },
+    {
+        "rfc3339_string_to_timestamp_us",
+        (PyCFunction) rfc3339_string_to_timestamp_us,
+        METH_VARARGS,
+        PyDoc_STR(
+            "Parse RFC3339 date-time string to int microseconds since epoch."
+        )
+    },
     {
         "utcnow_to_string",
         (PyCFunction) utcnow_to_string,
         METH_NOARGS,
         PyDoc_STR("Current UTC date and time RFC3339 compliant date-time string.")
     },
+    {
+        "to_http_date",
+        (PyCFunction) to_http_date,
+        METH_O,
+        PyDoc_STR(
+            "datetime, UDateTime or POSIX timestamp -> HTTP-date string "
+            "(IMF-fixdate, GMT)."
+        )
+    },
+    {
+        "utcnow_to_http_date",
+        (PyCFunction) utcnow_to_http_date,
+        METH_NOARGS,
+        PyDoc_STR(
+            "Current time HTTP-date string, cached per second."
+        )
+    },
+    {
+        "from_http_date",
+        (PyCFunction) from_http_date,
+        METH_VARARGS,
+        PyDoc_STR(
+            "Parse HTTP-date string (IMF-fixdate, RFC 850 or asctime)."
+        )
+    },
     {
         "now_to_string",
         (PyCFunction) localnow_to_string,
         METH_NOARGS,
         PyDoc_STR("Local date and time RFC3339 compliant date-time string.")
     },
+    {
+        "floor_timestamps_us",
+        (PyCFunction) floor_timestamps_us,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "values, out, unit[, offset] -> write the start of each value's "
+            "second, minute, hour, day, week, month or year bucket in UTC "
+            "offset minutes to out. int64 microseconds since epoch buffers."
+        )
+    },
+    {
+        "normalize_many",
+        (PyCFunction) normalize_many,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "strings[, precision] -> list of RFC3339 date-time strings "
+            "converted to UTC with \"Z\" offset and precision (0 - 6) "
+            "fraction digits."
+        )
+    },
+    {
+        "is_valid",
+        (PyCFunction) is_valid,
+        METH_VARARGS,
+        PyDoc_STR("True if string is a valid RFC3339 date-time string.")
+    },
+    {
+        "validate_many",
+        (PyCFunction) validate_many,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "strings[, out] -> one byte per string, 1 if valid RFC3339 "
+            "date-time string else 0, written to out or a new bytearray."
+        )
+    },
+    {
+        "diff_us",
+        (PyCFunction) diff_us,
+        METH_VARARGS,
+        PyDoc_STR(
+            "a, b -> signed microseconds a - b of two RFC3339 date-time "
+            "strings."
+        )
+    },
+    {
+        "diff_many",
+        (PyCFunction) diff_many,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "a_strings, b_strings, out -> out[i] = diff_us(a_strings[i], "
+            "b_strings[i]), out is an int64 buffer."
+        )
+    },
+    {
+        "enable_coarse_clock",
+        (PyCFunction) enable_coarse_clock,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "[resolution] -> serve utcnow(), now(), utcnow_to_string() and "
+            "now_to_string() from a snapshot refreshed every resolution "
+            "seconds (default 0.001) by a background thread."
+        )
+    },
+    {
+        "disable_coarse_clock",
+        (PyCFunction) disable_coarse_clock,
+        METH_NOARGS,
+        PyDoc_STR("Stop the coarse clock thread, read the clock per call.")
+    },
+    {
+        "encode_datetimes",
+        (PyCFunction) encode_datetimes,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "obj[, dates] -> copy of nested dicts, lists and tuples with "
+            "datetime (and date if dates is true) objects replaced by RFC3339 "
+            "strings."
+        )
+    },
+    {
+        "json_default",
+        (PyCFunction) json_default,
+        METH_O,
+        PyDoc_STR(
+            "json.dumps() default hook, datetime and date objects to RFC3339 "
+            "strings."
+        )
+    },
+    {
+        "to_bytes",
+        (PyCFunction) to_bytes,
+        METH_VARARGS,
+        PyDoc_STR(
+            "datetime -> 10 bytes, little-endian int64 microseconds since "
+            "epoch and int16 UTC offset in minutes."
+        )
+    },
+    {
+        "from_bytes",
+        (PyCFunction) from_bytes,
+        METH_VARARGS,
+        PyDoc_STR("10 bytes packed by to_bytes() -> datetime.")
+    },
+    {
+        "to_bytes_many",
+        (PyCFunction) to_bytes_many,
+        METH_VARARGS,
+        PyDoc_STR("sequence of datetime -> concatenated to_bytes() output.")
+    },
+    {
+        "from_bytes_many",
+        (PyCFunction) from_bytes_many,
+        METH_VARARGS,
+        PyDoc_STR("Bytes packed by to_bytes_many() -> list of datetime.")
+    },
+    {
+        "timestamps_to_rfc3339_strings",
+        (PyCFunction) timestamps_to_rfc3339_strings,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "values[, offset, unit, packed] -> RFC3339 date-time strings of "
+            "an int64 buffer of microseconds (unit 'us') or nanoseconds "
+            "(unit 'ns') since epoch in UTC offset minutes. List of strings, "
+            "or bytes of 32 byte wide ASCII records if packed is true."
+        )
+    },
+    {
+        "stats",
+        (PyCFunction) get_stats,
+        METH_NOARGS,
+        PyDoc_STR(
+            "Per entry point counters (calls, date_invalid, time_invalid, "
+            "fast_path, fallback, bytes). Empty unless built with "
+            "UDATETIME_STATS=1."
+        )
+    },
+    {
+        "reset_stats",
+        (PyCFunction) reset_stats,
+        METH_NOARGS,
+        PyDoc_STR("Reset the stats() counters to 0.")
+    },
+    {
+        "enable_string_cache",
+        (PyCFunction) enable_string_cache,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "[size] -> cache from_string() results for up to size recently "
+            "parsed strings, returns the StringCache in use."
+        )
+    },
+    {
+        "disable_string_cache",
+        (PyCFunction) disable_string_cache,
+        METH_NOARGS,
+        PyDoc_STR("Stop caching from_string() results.")
+    },
+    {
+        "rfc3339_strings_to_components",
+        (PyCFunction) rfc3339_strings_to_components,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "strings[, year, month, day, hour, minute, second, usec, offset, "
+            "wday] -> parse RFC3339 date-time strings and write each "
+            "component to its int32/int64 buffer, None skips a component. "
+            "Returns the number of strings."
+        )
+    },
     {NULL}
 };
 
@@ -1043,6 +4024,42 @@ initrfc3339(void)
     Py_INCREF(&FixedOffset_type);
     PyModule_AddObject(m, "TZFixedOffset", (PyObject *)&FixedOffset_type);
 
+    UDateTime_type.tp_new = UDateTime_new;
+    UDateTime_type.tp_methods = UDateTime_methods;
+    UDateTime_type.tp_members = UDateTime_members;
+    UDateTime_type.tp_richcompare = UDateTime_richcompare;
+
+    if (PyType_Ready(&UDateTime_type) < 0)
+#ifdef _PYTHON3
+        return NULL;
+#else
+        return;
+#endif
+
+    Py_INCREF(&UDateTime_type);
+    PyModule_AddObject(m, "UDateTime", (PyObject *)&UDateTime_type);
+
+    StringCache_type.tp_new = PyType_GenericNew;
+    StringCache_type.tp_methods = StringCache_methods;
+    StringCache_type.tp_members = StringCache_members;
+    StringCache_type.tp_init = (initproc)StringCache_init;
+
+    if (PyType_Ready(&StringCache_type) < 0)
+#ifdef _PYTHON3
+        return NULL;
+#else
+        return;
+#endif
+
+    Py_INCREF(&StringCache_type);
+    PyModule_AddObject(m, "StringCache", (PyObject *)&StringCache_type);
+
+    if (DateTimeTuple_type.tp_name == NULL)
+        PyStructSequence_InitType(&DateTimeTuple_type, &DateTimeTuple_desc);
+
+    Py_INCREF(&DateTimeTuple_type);
+    PyModule_AddObject(m, "DateTimeTuple", (PyObject *)&DateTimeTuple_type);
+
 #ifdef _PYTHON3
     return m;
 #endif
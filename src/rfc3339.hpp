@@ -0,0 +1,563 @@
+/*
+ * Header-only C++17 counterpart of the rfc3339.c core. Same grammar and
+ * validation as _parse_date_time, same output as _format_date_time and
+ * _pack_date_time, but constexpr and without Python, libc time functions or
+ * sprintf. Only the std::string overload of to_string() allocates. C++20
+ * adds std::span overloads of to_string(), to_bytes() and from_bytes().
+ *
+ * Digit fields are fixed width, the short or signed fields sscanf lets
+ * through in rfc3339.c (e.g. 2016-07-18T1:58:26Z) are rejected.
+ *
+ *   using namespace rfc3339::literals;
+ *   constexpr auto t = "2016-07-18T12:58:26.485897+02:00"_rfc3339;
+ *   static_assert(t.time_since_epoch().count() == 1468839506485897);
+ *
+ * Invalid literals fail to compile, at runtime from_string() throws
+ * std::invalid_argument and parse_date_time() reports through ok flags.
+ */
+#ifndef RFC3339_HPP
+#define RFC3339_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define RFC3339_HAVE_SPAN 1
+#endif
+#endif
+
+namespace rfc3339 {
+
+constexpr int DAY_IN_SECS = 86400;
+constexpr int HOUR_IN_SECS = 3600;
+constexpr int MINUTE_IN_SECS = 60;
+constexpr int HOUR_IN_MINS = 60;
+constexpr long long SEC_IN_USECS = 1000000LL;
+constexpr std::size_t PACKED_DATE_TIME_SIZE = 10;
+constexpr std::size_t DATE_TIME_STRING_SIZE = 32;
+
+// 0001-01-01T00:00:00Z - 1 day, 9999-12-31T23:59:59Z + 1 day
+constexpr long long MIN_TIMESTAMP_US = -62135683200LL * SEC_IN_USECS;
+constexpr long long MAX_TIMESTAMP_US = 253402387199LL * SEC_IN_USECS;
+
+template <class Duration>
+using sys_time = std::chrono::time_point<std::chrono::system_clock, Duration>;
+using sys_time_us = sys_time<std::chrono::microseconds>;
+
+struct date_struct {
+    unsigned int year = 0;
+    unsigned int month = 0;
+    unsigned int day = 0;
+    unsigned int wday = 0; // Sunday = 1
+    bool ok = false;
+};
+
+struct time_struct {
+    unsigned int hour = 0;
+    unsigned int minute = 0;
+    unsigned int second = 0;
+    unsigned int fraction = 0;
+    int offset = 0; // UTC offset in minutes
+    bool ok = false;
+};
+
+struct date_time_struct {
+    date_struct date;
+    time_struct time;
+    bool ok = false;
+};
+
+namespace detail {
+
+constexpr bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/*
+ * Reads count digits at pos of the space stripped string, advances pos.
+ * Returns -1 if there are not count digits.
+ */
+constexpr int read_digits(std::string_view s, std::size_t &pos,
+                          unsigned int count) {
+    int value = 0;
+
+    for (unsigned int i = 0; i < count; i++) {
+        while (pos < s.size() && s[pos] == ' ')
+            pos++;
+
+        if (pos >= s.size() || !is_digit(s[pos]))
+            return -1;
+
+        value = value * 10 + (s[pos++] - '0');
+    }
+
+    return value;
+}
+
+// Next non space character or 0 at the end of the string
+constexpr char peek(std::string_view s, std::size_t &pos) {
+    while (pos < s.size() && s[pos] == ' ')
+        pos++;
+
+    return pos < s.size() ? s[pos] : 0;
+}
+
+constexpr void put_digits(char *out, unsigned int value, unsigned int count) {
+    for (unsigned int i = count; i > 0; i--) {
+        out[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+} // namespace detail
+
+/*
+ * Days since 1970-01-01 of the proleptic Gregorian date y-m-d
+ * (Howard Hinnant's days_from_civil), integer arithmetic only
+ */
+constexpr long long days_from_civil(int year, unsigned int month,
+                                    unsigned int day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned int yoe = static_cast<unsigned int>(year - era * 400);
+    const unsigned int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2)
+        / 5 + day - 1;
+    const unsigned int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return static_cast<long long>(era) * 146097 + doe - 719468;
+}
+
+/*
+ * Proleptic Gregorian date of the given days since 1970-01-01
+ * (Howard Hinnant's civil_from_days), inverse of days_from_civil
+ */
+constexpr void civil_from_days(long long days, int &year, unsigned int &month,
+                               unsigned int &day) {
+    days += 719468;
+    const long long era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned int doe = static_cast<unsigned int>(days - era * 146097);
+    const unsigned int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096)
+        / 365;
+    const unsigned int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned int mp = (5 * doy + 2) / 153;
+
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int>(yoe + era * 400 + (month <= 2));
+}
+
+/*
+ * Integer division rounding towards negative infinity, divisor > 0
+ */
+constexpr long long floor_div(long long a, long long b) {
+    long long q = a / b;
+
+    if ((a % b) != 0 && a < 0)
+        q -= 1;
+
+    return q;
+}
+
+/*
+ * Parse a RFC3339 full-date
+ * full-date = date-fullyear "-" date-month "-" date-mday
+ * Ex. 2007-08-31
+ *
+ * Characters after date-mday are being ignored, spaces are ignored.
+ */
+constexpr date_struct parse_date(std::string_view date_string) {
+    date_struct d;
+    std::size_t pos = 0;
+
+    const int year = detail::read_digits(date_string, pos, 4);
+    if (year < 1 || detail::peek(date_string, pos) != '-') return d;
+    pos++;
+
+    const int month = detail::read_digits(date_string, pos, 2);
+    if (month < 1 || month > 12 || detail::peek(date_string, pos) != '-')
+        return d;
+    pos++;
+
+    const int day = detail::read_digits(date_string, pos, 2);
+    if (day < 1) return d;
+
+    // Validate max day based on month, the day must survive the round trip
+    const long long days = days_from_civil(year, month, day);
+    int y = 0;
+    unsigned int m = 0, md = 0;
+    civil_from_days(days, y, m, md);
+    if (md != static_cast<unsigned int>(day)) return d;
+
+    d.year = static_cast<unsigned int>(year);
+    d.month = static_cast<unsigned int>(month);
+    d.day = static_cast<unsigned int>(day);
+    // 1970-01-01 was a Thursday, wday is tm_wday + 1 (Sunday = 1)
+    d.wday = static_cast<unsigned int>(((days % 7) + 11) % 7) + 1;
+    d.ok = true;
+    return d;
+}
+
+/*
+ * Parse a RFC3339 partial-time or full-time
+ * partial-time = time-hour ":" time-minute ":" time-second [time-secfrac]
+ * full-time    = partial-time time-offset
+ * Ex. 16:47:31.123+00:00, 18:21:00.123, 18:21:00
+ *
+ * If time_string is partial-time timezone will be UTC. If time_string is
+ * date-time ("T" or "t" separated), the full-date part will be ignored.
+ * time-secfrac must have 1 - 6 digits.
+ */
+constexpr time_struct parse_time(std::string_view time_string) {
+    time_struct t;
+    std::size_t pos = 0;
+
+    // skip full-date of a date-time string, index 10 without spaces
+    for (unsigned int chars = 0; detail::peek(time_string, pos); pos++) {
+        if (chars++ == 10) {
+            if (time_string[pos] == 'T' || time_string[pos] == 't') {
+                pos++;
+            } else {
+                pos = 0;
+            }
+            break;
+        }
+    }
+
+    if (!detail::peek(time_string, pos))
+        pos = 0;
+
+    const int hour = detail::read_digits(time_string, pos, 2);
+    if (hour < 0 || hour > 23 || detail::peek(time_string, pos) != ':')
+        return t;
+    pos++;
+
+    const int minute = detail::read_digits(time_string, pos, 2);
+    if (minute < 0 || minute > 59 || detail::peek(time_string, pos) != ':')
+        return t;
+    pos++;
+
+    const int second = detail::read_digits(time_string, pos, 2);
+    if (second < 0 || second > 59) return t;
+
+    t.hour = static_cast<unsigned int>(hour);
+    t.minute = static_cast<unsigned int>(minute);
+    t.second = static_cast<unsigned int>(second);
+
+    char c = detail::peek(time_string, pos);
+
+    // check for fractions, msec or usec
+    if (c == '.') {
+        pos++;
+        unsigned int digits = 0;
+
+        while (digits < 6 &&
+               detail::is_digit(detail::peek(time_string, pos))) {
+            t.fraction = t.fraction * 10 + (time_string[pos++] - '0');
+            digits++;
+        }
+
+        if (digits == 0) return t;
+
+        for (; digits < 6; digits++)
+            t.fraction *= 10;
+
+        c = detail::peek(time_string, pos);
+    }
+
+    // parse timezone, no timezone implicates UTC
+    if (c == 'Z' || c == 'z') {
+        pos++;
+    } else if (c == '+' || c == '-') {
+        pos++;
+
+        const int tz_hour = detail::read_digits(time_string, pos, 2);
+        if (tz_hour < 0 || tz_hour > 23 ||
+                detail::peek(time_string, pos) != ':')
+            return t;
+        pos++;
+
+        const int tz_minute = detail::read_digits(time_string, pos, 2);
+        if (tz_minute < 0 || tz_minute > 59) return t;
+
+        t.offset = tz_hour * HOUR_IN_MINS + tz_minute;
+        if (c == '-')
+            t.offset = -t.offset;
+    }
+
+    t.ok = detail::peek(time_string, pos) == 0;
+    return t;
+}
+
+/*
+ * Parse a RFC3339 date-time
+ * date-time = full-date "T" full-time
+ * Ex. 2007-08-31T16:47:31+00:00 or 2007-12-24T18:21:00.123Z
+ *
+ * Using " " instead of "T" is NOT supported.
+ */
+constexpr date_time_struct parse_date_time(std::string_view datetime_string) {
+    date_time_struct dt;
+
+    dt.date = parse_date(datetime_string);
+    if (!dt.date.ok)
+        return dt;
+
+    dt.time = parse_time(datetime_string);
+    if (!dt.time.ok)
+        return dt;
+
+    dt.ok = true;
+    return dt;
+}
+
+/*
+ * Convert date_time_struct to microseconds since epoch (UTC), honoring
+ * time.offset
+ */
+constexpr long long date_time_to_timestamp_us(const date_time_struct &dt) {
+    long long secs = days_from_civil(
+        static_cast<int>(dt.date.year), dt.date.month, dt.date.day
+    ) * DAY_IN_SECS;
+
+    secs += dt.time.hour * HOUR_IN_SECS;
+    secs += dt.time.minute * MINUTE_IN_SECS;
+    secs += dt.time.second;
+    secs -= dt.time.offset * MINUTE_IN_SECS;
+
+    return secs * SEC_IN_USECS + dt.time.fraction;
+}
+
+/*
+ * Convert microseconds since epoch to date_time_struct in the given UTC
+ * offset (minutes). ok is false if the local date is out of 0001 - 9999.
+ */
+constexpr date_time_struct timestamp_us_to_date_time(long long timestamp_us,
+                                                     int offset = 0) {
+    date_time_struct dt;
+
+    if (timestamp_us < MIN_TIMESTAMP_US || timestamp_us > MAX_TIMESTAMP_US ||
+            offset <= -24 * HOUR_IN_MINS || offset >= 24 * HOUR_IN_MINS)
+        return dt;
+
+    const long long local_us = timestamp_us +
+        static_cast<long long>(offset) * MINUTE_IN_SECS * SEC_IN_USECS;
+    const long long days = floor_div(local_us, DAY_IN_SECS * SEC_IN_USECS);
+    const long long day_us = local_us - days * DAY_IN_SECS * SEC_IN_USECS;
+    const unsigned int secs = static_cast<unsigned int>(day_us / SEC_IN_USECS);
+    int year = 0;
+
+    civil_from_days(days, year, dt.date.month, dt.date.day);
+    if (year < 1 || year > 9999)
+        return dt;
+
+    dt.date.year = static_cast<unsigned int>(year);
+    dt.date.wday = static_cast<unsigned int>(((days % 7) + 11) % 7) + 1;
+    dt.date.ok = true;
+
+    dt.time.hour = secs / HOUR_IN_SECS;
+    dt.time.minute = (secs % HOUR_IN_SECS) / MINUTE_IN_SECS;
+    dt.time.second = secs % MINUTE_IN_SECS;
+    dt.time.fraction = static_cast<unsigned int>(day_us % SEC_IN_USECS);
+    dt.time.offset = offset;
+    dt.time.ok = true;
+
+    dt.ok = true;
+    return dt;
+}
+
+/*
+ * Write the RFC3339 date-time string of dt, DATE_TIME_STRING_SIZE chars
+ * without NUL terminator, to out
+ * Ex. 2016-07-18T12:58:26.485897+02:00
+ */
+constexpr void format_date_time(const date_time_struct &dt, char *out) {
+    int offset = dt.time.offset;
+    char sign = '+';
+
+    if (offset < 0) {
+        offset = -offset;
+        sign = '-';
+    }
+
+    detail::put_digits(out, dt.date.year, 4);
+    out[4] = '-';
+    detail::put_digits(out + 5, dt.date.month, 2);
+    out[7] = '-';
+    detail::put_digits(out + 8, dt.date.day, 2);
+    out[10] = 'T';
+    detail::put_digits(out + 11, dt.time.hour, 2);
+    out[13] = ':';
+    detail::put_digits(out + 14, dt.time.minute, 2);
+    out[16] = ':';
+    detail::put_digits(out + 17, dt.time.second, 2);
+    out[19] = '.';
+    detail::put_digits(out + 20, dt.time.fraction, 6);
+    out[26] = sign;
+    detail::put_digits(out + 27, offset / HOUR_IN_MINS, 2);
+    out[29] = ':';
+    detail::put_digits(out + 30, offset % HOUR_IN_MINS, 2);
+}
+
+/*
+ * Pack date-time into PACKED_DATE_TIME_SIZE bytes: little-endian int64
+ * microseconds since epoch (UTC) followed by little-endian int16 UTC
+ * offset in minutes, the to_bytes() wire format
+ */
+constexpr void pack_date_time(const date_time_struct &dt,
+                              unsigned char *packed) {
+    const unsigned long long timestamp_us =
+        static_cast<unsigned long long>(date_time_to_timestamp_us(dt));
+    const unsigned int offset = static_cast<unsigned int>(dt.time.offset);
+
+    for (int i = 0; i < 8; i++)
+        packed[i] = static_cast<unsigned char>(timestamp_us >> (i * 8));
+
+    packed[8] = static_cast<unsigned char>(offset);
+    packed[9] = static_cast<unsigned char>(offset >> 8);
+}
+
+/*
+ * Unpack PACKED_DATE_TIME_SIZE bytes written by pack_date_time, ok is
+ * false for out of range values
+ */
+constexpr date_time_struct unpack_date_time(const unsigned char *packed) {
+    unsigned long long timestamp_us = 0;
+
+    for (int i = 0; i < 8; i++)
+        timestamp_us |= static_cast<unsigned long long>(packed[i]) << (i * 8);
+
+    const int offset = static_cast<short>(packed[8] | (packed[9] << 8));
+
+    return timestamp_us_to_date_time(
+        static_cast<long long>(timestamp_us), offset
+    );
+}
+
+/*
+ * Parse RFC3339 date-time string, throws std::invalid_argument with the
+ * Python module's messages. In a constant expression invalid strings are
+ * compile errors.
+ */
+constexpr date_time_struct from_string(std::string_view rfc3339_string) {
+    const date_time_struct dt = parse_date_time(rfc3339_string);
+
+    if (!dt.date.ok)
+        throw std::invalid_argument(
+            "Invalid RFC3339 date-time string. Date invalid."
+        );
+
+    if (!dt.time.ok)
+        throw std::invalid_argument(
+            "Invalid RFC3339 date-time string. Time invalid."
+        );
+
+    return dt;
+}
+
+constexpr sys_time_us to_sys_time(const date_time_struct &dt) {
+    return sys_time_us(
+        std::chrono::microseconds(date_time_to_timestamp_us(dt))
+    );
+}
+
+/*
+ * tp as date-time in the given UTC offset (minutes), sub-microsecond
+ * precision is floored. Throws std::out_of_range outside 0001 - 9999.
+ */
+template <class Duration>
+constexpr date_time_struct from_sys_time(sys_time<Duration> tp,
+                                         int offset = 0) {
+    const date_time_struct dt = timestamp_us_to_date_time(
+        std::chrono::floor<std::chrono::microseconds>(tp)
+            .time_since_epoch().count(),
+        offset
+    );
+
+    if (!dt.ok)
+        throw std::out_of_range("date value out of range");
+
+    return dt;
+}
+
+constexpr long long diff_us(std::string_view a, std::string_view b) {
+    return date_time_to_timestamp_us(from_string(a)) -
+        date_time_to_timestamp_us(from_string(b));
+}
+
+/*
+ * Format into a caller provided buffer of at least DATE_TIME_STRING_SIZE
+ * chars, returns a view of the written string
+ */
+constexpr std::string_view to_string(const date_time_struct &dt, char *out,
+                                     std::size_t size) {
+    if (size < DATE_TIME_STRING_SIZE)
+        throw std::length_error("out is smaller than 32 chars.");
+
+    format_date_time(dt, out);
+    return std::string_view(out, DATE_TIME_STRING_SIZE);
+}
+
+inline std::string to_string(const date_time_struct &dt) {
+    std::string datetime_string(DATE_TIME_STRING_SIZE, '0');
+    format_date_time(dt, &datetime_string[0]);
+    return datetime_string;
+}
+
+/*
+ * Pack into a caller provided buffer of at least PACKED_DATE_TIME_SIZE
+ * bytes, the 10 byte format of the Python module's to_bytes()
+ */
+constexpr void to_bytes(const date_time_struct &dt, unsigned char *out) {
+    pack_date_time(dt, out);
+}
+
+/*
+ * Unpack PACKED_DATE_TIME_SIZE bytes, throws std::out_of_range for out of
+ * range timestamps or offsets
+ */
+constexpr date_time_struct from_bytes(const unsigned char *packed) {
+    const date_time_struct dt = unpack_date_time(packed);
+
+    if (!dt.ok)
+        throw std::out_of_range("date value out of range");
+
+    return dt;
+}
+
+#ifdef RFC3339_HAVE_SPAN
+constexpr std::string_view to_string(const date_time_struct &dt,
+                                     std::span<char> out) {
+    return to_string(dt, out.data(), out.size());
+}
+
+constexpr void to_bytes(const date_time_struct &dt,
+                        std::span<unsigned char, PACKED_DATE_TIME_SIZE> out) {
+    to_bytes(dt, out.data());
+}
+
+constexpr date_time_struct from_bytes(
+        std::span<const unsigned char, PACKED_DATE_TIME_SIZE> packed) {
+    return from_bytes(packed.data());
+}
+#endif
+
+namespace literals {
+
+/*
+ * "2016-07-18T12:58:26Z"_rfc3339 -> sys_time_us, validated at compile
+ * time when used in a constant expression
+ */
+constexpr sys_time_us operator""_rfc3339(const char *s, std::size_t length) {
+    return to_sys_time(from_string(std::string_view(s, length)));
+}
+
+} // namespace literals
+
+} // namespace rfc3339
+
+#endif // RFC3339_HPP
@@ -0,0 +1,145 @@
+/*
+ * Compile time checks of src/rfc3339.hpp, built and run by `make test-hpp`
+ * with C++17 and C++20. Compiling is the test, main() only covers what
+ * needs exceptions at runtime.
+ */
+#include "rfc3339.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string_view>
+
+using namespace rfc3339::literals;
+
+namespace {
+
+constexpr bool is_valid(std::string_view s) {
+    return rfc3339::parse_date_time(s).ok;
+}
+
+constexpr long long timestamp_us(std::string_view s) {
+    return rfc3339::date_time_to_timestamp_us(rfc3339::from_string(s));
+}
+
+constexpr bool round_trips(std::string_view s) {
+    char out[rfc3339::DATE_TIME_STRING_SIZE] = {};
+    rfc3339::format_date_time(rfc3339::from_string(s), out);
+    return std::string_view(out, sizeof(out)) == s;
+}
+
+constexpr bool bytes_round_trip(std::string_view s) {
+    const rfc3339::date_time_struct dt = rfc3339::from_string(s);
+    unsigned char packed[rfc3339::PACKED_DATE_TIME_SIZE] = {};
+    rfc3339::to_bytes(dt, packed);
+    const rfc3339::date_time_struct back = rfc3339::from_bytes(packed);
+
+    return rfc3339::date_time_to_timestamp_us(back) ==
+            rfc3339::date_time_to_timestamp_us(dt) &&
+        back.time.offset == dt.time.offset &&
+        back.date.wday == dt.date.wday;
+}
+
+constexpr unsigned char packed_epoch_offset(int offset) {
+    unsigned char packed[rfc3339::PACKED_DATE_TIME_SIZE] = {};
+    rfc3339::to_bytes(rfc3339::timestamp_us_to_date_time(0, offset), packed);
+    return packed[8];
+}
+
+// valid
+static_assert(is_valid("2016-07-18T12:58:26Z"));
+static_assert(is_valid("2016-07-18T12:58:26.485897+02:00"));
+static_assert(is_valid("0001-01-01T00:00:00Z"));
+static_assert(is_valid("9999-12-31T23:59:59.999999Z"));
+
+// invalid
+static_assert(!is_valid(""));
+static_assert(!is_valid("Hello World"));
+static_assert(!is_valid("2016-13-18T12:58:26Z"));
+static_assert(!is_valid("2016-07-32T12:58:26Z"));
+static_assert(!is_valid("2016-07-18T24:58:26Z"));
+static_assert(!is_valid("2016-07-18T12:60:26Z"));
+static_assert(!is_valid("2016-07-18T1:58:26Z"));
+static_assert(!is_valid("2016-07-18T12:58:26+24:00"));
+static_assert(!is_valid("2016-07-18T12:58:26Zjunk"));
+
+// Feb 29 only in leap years
+static_assert(is_valid("2016-02-29T00:00:00Z"));
+static_assert(is_valid("2000-02-29T00:00:00Z"));
+static_assert(!is_valid("2015-02-29T00:00:00Z"));
+static_assert(!is_valid("1900-02-29T00:00:00Z"));
+static_assert(!is_valid("2016-02-30T00:00:00Z"));
+
+// offsets
+static_assert(timestamp_us("1970-01-01T00:00:00Z") == 0);
+static_assert(timestamp_us("1970-01-01T01:00:00+01:00") == 0);
+static_assert(timestamp_us("1969-12-31T19:00:00-05:00") == 0);
+static_assert(timestamp_us("1970-01-01T00:30:00+00:30") == 0);
+static_assert(rfc3339::from_string("2016-07-18T12:58:26-02:30").time.offset ==
+              -150);
+static_assert(rfc3339::diff_us("2016-07-18T12:00:00+02:00",
+                               "2016-07-18T10:00:00Z") == 0);
+
+// fields and wday, Sunday = 1
+static_assert(rfc3339::from_string("2016-07-18T12:58:26Z").date.wday == 2);
+static_assert(rfc3339::from_string("2016-07-18T12:58:26.5Z").time.fraction ==
+              500000);
+
+// literals
+static_assert(
+    "2016-07-18T12:58:26.485897+02:00"_rfc3339.time_since_epoch().count() ==
+    1468839506485897
+);
+
+// formatting and packing
+static_assert(round_trips("2016-07-18T12:58:26.485897+02:00"));
+static_assert(round_trips("0001-01-01T00:00:00.000000-23:59"));
+static_assert(round_trips("9999-12-31T23:59:59.999999+23:59"));
+static_assert(bytes_round_trip("2016-07-18T12:58:26.485897+02:00"));
+static_assert(bytes_round_trip("1969-12-31T23:59:59.999999-05:00"));
+static_assert(bytes_round_trip("0001-01-01T00:00:00Z"));
+static_assert(packed_epoch_offset(120) == 120);
+
+template <class F>
+bool throws(F f) {
+    try {
+        f();
+    } catch (const std::exception &) {
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace
+
+int main() {
+    int failed = 0;
+    const unsigned char bad_offset[rfc3339::PACKED_DATE_TIME_SIZE] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0xa0, 0x05
+    };
+    char small[16] = {};
+
+    failed += !throws([] { rfc3339::from_string("2016-02-30T00:00:00Z"); });
+    failed += !throws([&] { rfc3339::from_bytes(bad_offset); });
+    failed += !throws([&] {
+        rfc3339::to_string(rfc3339::from_string("2016-07-18T12:58:26Z"),
+                           small, sizeof(small));
+    });
+    failed += rfc3339::to_string(
+        rfc3339::from_string("2016-07-18T12:58:26Z")
+    ) != "2016-07-18T12:58:26.000000+00:00";
+
+#ifdef RFC3339_HAVE_SPAN
+    unsigned char packed[rfc3339::PACKED_DATE_TIME_SIZE] = {};
+    rfc3339::to_bytes(rfc3339::from_string("2016-07-18T12:58:26Z"),
+                      std::span<unsigned char, 10>(packed));
+    failed += rfc3339::from_bytes(
+        std::span<const unsigned char, 10>(packed)
+    ).time.second != 26;
+#endif
+
+    if (failed)
+        std::printf("rfc3339.hpp: %d checks failed\n", failed);
+
+    return failed != 0;
+}
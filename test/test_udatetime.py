@@ -1,9 +1,39 @@
 import unittest
-from datetime import datetime, timedelta, tzinfo
+from array import array
+from time import sleep, time
+import json
+import pickle
+import struct
+from datetime import date, datetime, timedelta, tzinfo
 import udatetime
 
 NO_DST = timedelta(0)
 
+try:
+    array('q')
+    HAVE_INT64_ARRAY = True
+except ValueError:
+    # Python 2: no 'q' typecode and array has no buffer interface
+    HAVE_INT64_ARRAY = False
+
+
+def int64_buffer(values=()):
+    """Writable buffer of native int64 items, array('q') where available."""
+    values = list(values)
+
+    if HAVE_INT64_ARRAY:
+        return array('q', values)
+
+    return bytearray(struct.pack('=%dq' % len(values), *values))
+
+
+def int64_values(buf):
+    """int64_buffer() contents as a list of ints."""
+    if HAVE_INT64_ARRAY:
+        return list(buf)
+
+    return list(struct.unpack('=%dq' % (len(buf) // 8), bytes(buf)))
+
 
 class Test(unittest.TestCase):
 
@@ -246,6 +276,702 @@ class Test(unittest.TestCase):
             udatetime.from_string('2016-07-15T12:33:20Z'),
         )
 
+    def test_to_timestamp(self):
+        rfc3339s = [
+            '2016-07-15T12:33:20.123000+01:30',
+            '2016-07-18T12:58:26.485897-02:00',
+            '1969-12-31T23:59:59.500000Z',
+            '2000-02-29T00:00:00Z',
+            '0001-01-01T00:00:00Z',
+            '9999-12-31T23:59:59.999999Z',
+        ]
+
+        for r in rfc3339s:
+            dt = udatetime.from_string(r)
+            delta = dt - datetime(1970, 1, 1, tzinfo=udatetime.TZFixedOffset(0))
+            us = (delta.days * 86400 + delta.seconds) * 1000000 +\
+                delta.microseconds
+
+            self.assertEqual(udatetime.string_to_timestamp_us(r), us)
+            self.assertAlmostEqual(
+                udatetime.string_to_timestamp(r), us / 1e6, places=6
+            )
+            self.assertAlmostEqual(
+                udatetime.to_timestamp(dt), us / 1e6, places=6
+            )
+
+        self.assertEqual(
+            udatetime.to_timestamp(datetime(2016, 7, 15, 12, 33, 20)),
+            1468586000.0
+        )
+
+        with self.assertRaises(ValueError):
+            udatetime.string_to_timestamp('2016-02-30T12:33:20Z')
+
+        with self.assertRaises(ValueError):
+            udatetime.string_to_timestamp_us('2016-07-15T25:33:20Z')
+
+    def test_from_string_tuple(self):
+        rfc3339s = [
+            '2016-07-15T12:33:20.123000+01:30',
+            '2016-07-17T00:00:00-02:00',
+            '1969-12-31T23:59:59.5Z',
+            '0001-01-01T00:00:00Z',
+            '2000-02-29T23:59:59.999999Z',
+        ]
+
+        for r in rfc3339s:
+            dt = udatetime.from_string(r)
+            t = udatetime.from_string_tuple(r)
+
+            self.assertEqual(t, (
+                dt.year, dt.month, dt.day, dt.hour, dt.minute, dt.second,
+                dt.microsecond, dt.utcoffset().total_seconds() // 60,
+                (dt.isoweekday() % 7) + 1
+            ))
+            self.assertEqual(t.year, dt.year)
+            self.assertEqual(t.usec, dt.microsecond)
+
+        with self.assertRaises(ValueError):
+            udatetime.from_string_tuple('2016-13-15T12:33:20Z')
+
+    def test_floor_timestamps_us(self):
+        values = int64_buffer([
+            udatetime.string_to_timestamp_us(r) for r in [
+                '2016-07-15T12:33:20.123000+01:30',
+                '2016-02-29T23:59:59.999999Z',
+                '2016-01-03T00:30:00+02:00',
+                '1969-12-31T23:59:59.500000Z',
+                '1969-03-02T05:06:07-05:00',
+                '0001-01-01T00:00:00Z',
+            ]
+        ])
+        out = int64_buffer([0] * len(values))
+
+        for offset in (0, 90, -300):
+            tz = udatetime.TZFixedOffset(offset)
+
+            for unit in ('second', 'minute', 'hour', 'day', 'week',
+                         'month', 'year'):
+                udatetime.floor_timestamps_us(values, out, unit, offset)
+
+                for v, o in zip(int64_values(values), int64_values(out)):
+                    if v < -62135596800000000 + 86400000000 * 7:
+                        continue  # bucket start before year 1
+
+                    dt = udatetime.fromtimestamp(0, tz) +\
+                        timedelta(microseconds=v)
+                    dt = dt.replace(microsecond=0)
+
+                    if unit != 'second':
+                        dt = dt.replace(second=0)
+                    if unit not in ('second', 'minute'):
+                        dt = dt.replace(minute=0)
+                    if unit not in ('second', 'minute', 'hour'):
+                        dt = dt.replace(hour=0)
+                    if unit == 'week':
+                        dt -= timedelta(days=dt.weekday())
+                    if unit in ('month', 'year'):
+                        dt = dt.replace(day=1)
+                    if unit == 'year':
+                        dt = dt.replace(month=1)
+
+                    self.assertEqual(
+                        o, udatetime.string_to_timestamp_us(
+                            udatetime.to_string(dt)
+                        )
+                    )
+
+        udatetime.floor_timestamps_us(values, values, 'day')
+        self.assertEqual(int64_values(values)[0], 1468540800000000)
+
+        with self.assertRaises(ValueError):
+            udatetime.floor_timestamps_us(values, out, 'fortnight')
+
+        with self.assertRaises(ValueError):
+            udatetime.floor_timestamps_us(values, int64_buffer(), 'day')
+
+        with self.assertRaises(TypeError):
+            udatetime.floor_timestamps_us(values, array('i', [0] * 6), 'day')
+
+        with self.assertRaises(ValueError):
+            udatetime.floor_timestamps_us(values, out, 'day', offset=1440)
+
+        for value in (-2 ** 63, 2 ** 63 - 1):
+            with self.assertRaises(OverflowError):
+                udatetime.floor_timestamps_us(
+                    int64_buffer([0, value]), int64_buffer([0, 0]), 'month'
+                )
+
+    def test_normalize_many(self):
+        rfc3339s = [
+            '2016-07-15T12:33:20.123456+01:30',
+            '2016-12-31T23:30:00.5-02:00',
+            '2016-02-29T00:15:00Z',
+            '2016-07-15 T 12:33:20',
+        ]
+
+        self.assertEqual(udatetime.normalize_many(rfc3339s), [
+            '2016-07-15T11:03:20.123456Z',
+            '2017-01-01T01:30:00.500000Z',
+            '2016-02-29T00:15:00.000000Z',
+            '2016-07-15T12:33:20.000000Z',
+        ])
+
+        self.assertEqual(udatetime.normalize_many(rfc3339s, precision=3)[0],
+                         '2016-07-15T11:03:20.123Z')
+        self.assertEqual(udatetime.normalize_many(rfc3339s, precision=0)[1],
+                         '2017-01-01T01:30:00Z')
+        self.assertEqual(udatetime.normalize_many(()), [])
+
+        with self.assertRaises(ValueError):
+            udatetime.normalize_many(['2016-07-15T12:33:20Z', 'Hello World'])
+
+        with self.assertRaises(ValueError):
+            udatetime.normalize_many(['0001-01-01T00:00:00+01:00'])
+
+        with self.assertRaises(ValueError):
+            udatetime.normalize_many(rfc3339s, precision=7)
+
+        with self.assertRaises(ValueError):
+            udatetime.normalize_many(['2016-07-15T12:33:20Z\x00garbage'])
+
+    def test_validate(self):
+        rfc3339s = [
+            '2016-07-15T12:33:20.123000+01:30',
+            '2016-02-29T12:33:20Z',
+            '2015-02-29T12:33:20Z',
+            '2016-04-31T12:33:20Z',
+            '2016-07-15T24:33:20Z',
+            '2016-07-15T12:33:20.1Z0',
+            '2016-07-15 T 12:33:20.123000 +01:30',
+            'Hello World',
+            None,
+            '2016-07-15T12:33:20Z\x00garbage',
+        ]
+        expected = [1, 1, 0, 0, 0, 0, 1, 0, 0, 0]
+
+        for r, e in zip(rfc3339s, expected):
+            if isinstance(r, str) and '\x00' not in r:
+                self.assertEqual(udatetime.is_valid(r), bool(e))
+
+        self.assertEqual(
+            udatetime.validate_many(rfc3339s), bytearray(expected)
+        )
+
+        out = bytearray(len(rfc3339s) + 2)
+        self.assertIs(udatetime.validate_many(rfc3339s, out), out)
+        self.assertEqual(out, bytearray(expected + [0, 0]))
+
+        with self.assertRaises(ValueError):
+            udatetime.validate_many(rfc3339s, bytearray(2))
+
+    def test_coarse_clock(self):
+        udatetime.enable_coarse_clock(0.001)
+
+        try:
+            # resolution update while running
+            udatetime.enable_coarse_clock(resolution=0.002)
+            sleep(0.01)
+
+            for _ in range(1000):
+                dt_now = datetime.utcnow()
+                now = udatetime.utcnow()
+                utc = udatetime.from_string(udatetime.utcnow_to_string())
+                local = udatetime.from_string(udatetime.now_to_string())
+
+                self.assertEqual(now.utcoffset(), timedelta(0))
+                self.assertEqual(utc.utcoffset(), timedelta(0))
+                self.assertEqual(local.utcoffset(), udatetime.now().utcoffset())
+
+                for dt in (now, utc, local):
+                    self.assertLess(
+                        abs(dt.replace(tzinfo=None) - dt_now -
+                            dt.utcoffset()),
+                        timedelta(seconds=1)
+                    )
+        finally:
+            udatetime.disable_coarse_clock()
+
+        udatetime.disable_coarse_clock()
+        self.assertIsInstance(udatetime.utcnow(), datetime)
+
+        # stop wakes the ticker instead of waiting out its resolution
+        udatetime.enable_coarse_clock(resolution=30)
+        sleep(0.01)
+        started = time()
+        udatetime.disable_coarse_clock()
+        self.assertLess(time() - started, 1)
+
+        for resolution in (0, 1e-10, 61):
+            with self.assertRaises(ValueError):
+                udatetime.enable_coarse_clock(resolution)
+
+    def test_encode_datetimes(self):
+        rfc3339 = '2016-07-15T12:33:20.123000+01:30'
+        dt = udatetime.from_string(rfc3339)
+        d = date(2016, 7, 15)
+        obj = {
+            'dt': dt,
+            'list': [dt, 1, 'a', None, (dt, d)],
+            'nested': {'d': d, 'naive': datetime(2016, 7, 15, 12, 33, 20)},
+        }
+
+        self.assertEqual(udatetime.encode_datetimes(obj), {
+            'dt': rfc3339,
+            'list': [rfc3339, 1, 'a', None, (rfc3339, d)],
+            'nested': {'d': d, 'naive': '2016-07-15T12:33:20.000000+00:00'},
+        })
+        self.assertEqual(
+            udatetime.encode_datetimes(obj, dates=True)['nested']['d'],
+            '2016-07-15'
+        )
+        self.assertEqual(obj['dt'], dt)
+        self.assertEqual(udatetime.encode_datetimes(dt), rfc3339)
+        self.assertEqual(udatetime.encode_datetimes(5), 5)
+
+        self.assertEqual(
+            json.dumps(obj, default=udatetime.json_default, sort_keys=True),
+            json.dumps(udatetime.encode_datetimes(obj, True), sort_keys=True)
+        )
+
+        with self.assertRaises(TypeError):
+            json.dumps({'a': object()}, default=udatetime.json_default)
+
+        class TZInvalid(tzinfo):
+            def utcoffset(self, dt=None):
+                return timedelta(seconds=0)
+
+            def dst(self, dt=None):
+                return timedelta(seconds=0)
+
+        with self.assertRaises(ValueError):
+            udatetime.encode_datetimes([datetime.now(TZInvalid())])
+
+    def test_to_and_from_bytes(self):
+        rfc3339s = [
+            '2016-07-15T12:33:20.123000+01:30',
+            '2016-07-18T12:58:26.485897-02:00',
+            '1969-12-31T23:59:59.500000+00:00',
+            '0001-01-01T00:00:00.000000+23:59',
+            '9999-12-31T23:59:59.999999-23:59',
+        ]
+        dts = [udatetime.from_string(r) for r in rfc3339s]
+
+        for r, dt in zip(rfc3339s, dts):
+            packed = udatetime.to_bytes(dt)
+            self.assertEqual(len(packed), 10)
+
+            udt = udatetime.from_bytes(packed)
+            self.assertEqual(udt, dt)
+            self.assertEqual(udatetime.to_string(udt), r)
+
+        self.assertEqual(
+            udatetime.to_bytes(udatetime.from_string('1970-01-01T00:00:01Z')),
+            b'\x40\x42\x0f\x00\x00\x00\x00\x00\x00\x00'
+        )
+
+        packed = udatetime.to_bytes_many(dts)
+        self.assertEqual(len(packed), 10 * len(dts))
+        self.assertEqual(packed[10:20], udatetime.to_bytes(dts[1]))
+        self.assertEqual(udatetime.from_bytes_many(packed), dts)
+        self.assertEqual(udatetime.from_bytes_many(b''), [])
+
+        with self.assertRaises(ValueError):
+            udatetime.from_bytes(packed[:9])
+
+        with self.assertRaises(ValueError):
+            udatetime.from_bytes_many(packed[:-1])
+
+        with self.assertRaises(ValueError) as context:
+            udatetime.from_bytes(b'\xff' * 7 + b'\x7f\x00\x00')
+        self.assertIn('Timestamp out of range', str(context.exception))
+
+        with self.assertRaises(ValueError) as context:
+            udatetime.from_bytes(b'\x00' * 8 + b'\xa0\x05')
+        self.assertIn('Offset out of range', str(context.exception))
+
+        with self.assertRaises(ValueError) as context:
+            udatetime.from_bytes_many(packed + b'\x00' * 8 + b'\xa0\x05')
+        self.assertIn('Offset out of range', str(context.exception))
+
+    def test_timestamps_to_strings(self):
+        rfc3339s = [
+            '2016-07-15T12:33:20.123000+01:30',
+            '2016-07-18T12:58:26.485897+01:30',
+            '1970-01-01T01:29:59.999999+01:30',
+            '0001-01-01T01:30:00.000000+01:30',
+            '9999-12-31T23:59:59.999999+01:30',
+        ]
+        timestamps = [udatetime.string_to_timestamp_us(r) for r in rfc3339s]
+        values = int64_buffer(timestamps)
+
+        self.assertEqual(
+            udatetime.timestamps_to_strings(values, offset=90), rfc3339s
+        )
+        self.assertEqual(
+            udatetime.timestamps_to_strings(values, 90, packed=True),
+            ''.join(rfc3339s).encode('ascii')
+        )
+        self.assertEqual(
+            udatetime.timestamps_to_strings(int64_buffer(timestamps[:1])),
+            ['2016-07-15T11:03:20.123000+00:00']
+        )
+
+        ns = int64_buffer([v * 1000 + 999 for v in timestamps[:3]])
+        self.assertEqual(
+            udatetime.timestamps_to_strings(ns, offset=90, unit='ns'),
+            rfc3339s[:3]
+        )
+        self.assertEqual(udatetime.timestamps_to_strings(int64_buffer()), [])
+
+        with self.assertRaises(ValueError):
+            udatetime.timestamps_to_strings(values, offset=-90)
+
+        with self.assertRaises(ValueError):
+            udatetime.timestamps_to_strings(values, unit='ms')
+
+        with self.assertRaises(ValueError):
+            udatetime.timestamps_to_strings(values, offset=24 * 60)
+
+        with self.assertRaises(TypeError):
+            udatetime.timestamps_to_strings([1, 2, 3])
+
+    def test_stats(self):
+        udatetime.reset_stats()
+        udatetime.from_string('2016-07-15T12:33:20Z')
+
+        for r in ('2016-02-30T12:33:20Z', '2016-07-15T24:33:20Z'):
+            with self.assertRaises(ValueError):
+                udatetime.from_string(r)
+
+        udatetime.validate_many(['2016-07-15T12:33:20Z', 'Hello World'])
+        udatetime.utcnow_to_string()
+
+        packed = udatetime.to_bytes(udatetime.utcnow())
+        udatetime.from_bytes(packed)
+        with self.assertRaises(ValueError):
+            udatetime.from_bytes(b'\x00' * 8 + b'\xa0\x05')
+
+        udatetime.from_bytes_many(packed * 3)
+        udatetime.timestamps_to_strings(int64_buffer([0, 1]))
+
+        cache = udatetime.StringCache(16)
+        cache.from_string('2016-07-15T12:33:20Z')
+        cache.from_string('2016-07-15T12:33:20Z')
+
+        for (to_x, value) in ((udatetime.to_string, '2016'),
+                              (udatetime.to_bytes, '2016'),
+                              (udatetime.to_http_date, 1e18)):
+            with self.assertRaises(ValueError):
+                to_x(value)
+
+        stats = udatetime.stats()
+        self.assertIsInstance(stats, dict)
+
+        if not stats:
+            self.skipTest('built without UDATETIME_STATS')
+
+        self.assertEqual(stats['from_string'], {
+            'calls': 3, 'date_invalid': 1, 'time_invalid': 1,
+            'fast_path': 0, 'fallback': 0, 'bytes': 60,
+        })
+        self.assertEqual(stats['validate_many']['calls'], 1)
+        self.assertEqual(stats['validate_many']['date_invalid'], 1)
+        self.assertEqual(stats['validate_many']['bytes'], 31)
+        self.assertEqual(stats['utcnow_to_string']['fallback'], 1)
+        self.assertEqual(stats['to_bytes']['bytes'], 10)
+        self.assertEqual(stats['from_bytes']['calls'], 2)
+        self.assertEqual(stats['from_bytes']['time_invalid'], 1)
+        self.assertEqual(stats['from_bytes_many']['bytes'], 30)
+        self.assertEqual(stats['timestamps_to_strings']['bytes'], 16)
+        self.assertEqual(stats['string_cache'], {
+            'calls': 2, 'date_invalid': 0, 'time_invalid': 0,
+            'fast_path': 1, 'fallback': 1, 'bytes': 20,
+        })
+        self.assertEqual(stats['to_string']['calls'], 1)
+        self.assertEqual(stats['to_string']['bytes'], 0)
+        self.assertEqual(stats['to_bytes']['calls'], 2)
+        self.assertEqual(stats['to_http_date']['calls'], 1)
+
+        udatetime.reset_stats()
+        self.assertEqual(udatetime.stats()['from_string']['calls'], 0)
+
+    def test_string_cache(self):
+        rfc3339 = '2016-07-15T12:33:20.123000+01:30'
+        cache = udatetime.StringCache(3)
+
+        dt = cache.from_string(rfc3339)
+        self.assertEqual(dt, udatetime.from_string(rfc3339))
+        self.assertIs(cache.from_string(rfc3339), dt)
+        self.assertIs(cache.from_string(''.join(list(rfc3339))), dt)
+        self.assertEqual((cache.hits, cache.misses), (2, 1))
+
+        for x in range(100):
+            r = '2016-07-15T12:33:%02d.%06dZ' % (x % 60, x)
+            self.assertEqual(
+                cache.from_string(r), udatetime.from_string(r)
+            )
+
+        with self.assertRaises(ValueError):
+            cache.from_string('2016-02-30T12:33:20Z')
+
+        cache.clear()
+        self.assertEqual((cache.hits, cache.misses), (0, 0))
+
+        with self.assertRaises(ValueError):
+            udatetime.StringCache(0)
+
+        global_cache = udatetime.enable_string_cache(size=16)
+
+        try:
+            self.assertIsInstance(global_cache, udatetime.StringCache)
+            dt = udatetime.from_string(rfc3339)
+            self.assertIs(udatetime.from_string(rfc3339), dt)
+            self.assertEqual(global_cache.hits, 1)
+
+            with self.assertRaises(ValueError):
+                udatetime.from_string('Hello World')
+        finally:
+            udatetime.disable_string_cache()
+
+        self.assertIsNot(udatetime.from_string(rfc3339), dt)
+
+        for size in (None, 16):
+            if size:
+                udatetime.enable_string_cache(size=size)
+
+            try:
+                # Python 2's "s" argument format raises TypeError
+                with self.assertRaises((TypeError, ValueError)):
+                    udatetime.from_string('2016-07-15T12:33:20Z\x00junk')
+            finally:
+                udatetime.disable_string_cache()
+
+        with self.assertRaises(ValueError):
+            cache.from_string('2016-07-15T12:33:20Z\x00junk')
+
+    def test_string_cache_reentrant(self):
+        rfc3339 = '2016-07-15T12:33:20.123000+01:30'
+        expected = udatetime.from_string(rfc3339)
+        cache = udatetime.StringCache(16)
+
+        class DisablingString(str):
+            def __eq__(self, other):
+                udatetime.disable_string_cache()
+                cache.clear()
+                return str.__eq__(self, other)
+
+            __hash__ = str.__hash__
+
+        udatetime.enable_string_cache(size=16)
+
+        try:
+            for x in range(3):
+                self.assertEqual(
+                    udatetime.from_string(DisablingString(rfc3339)), expected
+                )
+                self.assertEqual(
+                    cache.from_string(DisablingString(rfc3339)), expected
+                )
+        finally:
+            udatetime.disable_string_cache()
+
+    @unittest.skipUnless(HAVE_INT64_ARRAY, 'needs array int buffers')
+    def test_strings_to_components(self):
+        rfc3339s = [
+            '2016-07-15T12:33:20.123000+01:30',
+            '2016-07-17T00:00:00-02:00',
+            '1969-12-31T23:59:59.5Z',
+        ]
+        hour = array('i', [0] * 4)
+        wday = array('q', [0] * 3)
+        usec = array('i', [0] * 3)
+        offset = array('i', [0] * 3)
+
+        self.assertEqual(udatetime.strings_to_components(
+            rfc3339s, hour=hour, wday=wday, usec=usec, offset=offset
+        ), 3)
+
+        for (i, r) in enumerate(rfc3339s):
+            t = udatetime.from_string_tuple(r)
+            self.assertEqual(hour[i], t.hour)
+            self.assertEqual(wday[i], t.wday)
+            self.assertEqual(usec[i], t.usec)
+            self.assertEqual(offset[i], t.offset)
+
+        self.assertEqual(hour[3], 0)
+        self.assertEqual(udatetime.strings_to_components([], year=None), 0)
+
+        with self.assertRaises(ValueError):
+            udatetime.strings_to_components(rfc3339s, year=array('i', [0]))
+
+        with self.assertRaises(TypeError):
+            udatetime.strings_to_components(rfc3339s, year=array('d', [0] * 3))
+
+        with self.assertRaises(ValueError):
+            udatetime.strings_to_components(['2016-02-30T12:33:20Z'])
+
+        with self.assertRaises(ValueError):
+            udatetime.strings_to_components(['2016-07-15T12:33:20Z\x00junk'])
+
+    def test_udatetime_type(self):
+        rfc3339 = '2016-07-18T12:58:26.485897+02:00'
+        dt = udatetime.from_string(rfc3339)
+        u = udatetime.from_string(rfc3339, compact=True)
+
+        self.assertIsInstance(u, udatetime.UDateTime)
+        self.assertEqual(u.timestamp_us, 1468839506485897)
+        self.assertEqual(u.offset, 120)
+        self.assertEqual(u.to_string(), rfc3339)
+        self.assertEqual(str(u), rfc3339)
+        self.assertEqual(repr(u), "UDateTime('%s')" % rfc3339)
+        self.assertAlmostEqual(u.timestamp(), 1468839506.485897, places=6)
+        self.assertEqual(u.to_datetime(), dt)
+        self.assertEqual(u.to_datetime().utcoffset(), timedelta(hours=2))
+
+        self.assertEqual(udatetime.to_string(u), rfc3339)
+        self.assertEqual(udatetime.to_bytes(u), udatetime.to_bytes(dt))
+        self.assertEqual(udatetime.encode_datetimes([u]), [rfc3339])
+
+        local_epoch = udatetime.fromtimestamp(0, compact=True)
+        self.assertIsInstance(local_epoch, udatetime.UDateTime)
+        self.assertEqual(local_epoch.timestamp_us, 0)
+        self.assertEqual(
+            timedelta(minutes=local_epoch.offset),
+            udatetime.now().utcoffset()
+        )
+
+        epoch = udatetime.fromtimestamp(
+            0, tz=udatetime.TZFixedOffset(60), compact=True
+        )
+        self.assertEqual(epoch.timestamp_us, 0)
+        self.assertEqual(epoch.offset, 60)
+        self.assertEqual(epoch, udatetime.UDateTime(0, 60))
+        self.assertEqual(hash(epoch), hash(udatetime.UDateTime(0, 60)))
+        self.assertLess(epoch, u)
+        self.assertNotEqual(epoch, 0)
+
+        self.assertEqual(u - epoch, timedelta(microseconds=u.timestamp_us))
+        self.assertEqual(
+            (u + timedelta(days=1, microseconds=3)).to_string(),
+            '2016-07-19T12:58:26.485900+02:00'
+        )
+        self.assertEqual(
+            (timedelta(days=1) + u), u - timedelta(days=-1)
+        )
+
+        self.assertEqual(pickle.loads(pickle.dumps(u)).to_string(), rfc3339)
+
+        with self.assertRaises(ValueError):
+            udatetime.from_string('2016-02-30T12:58:26Z', compact=True)
+
+        with self.assertRaises(OverflowError):
+            udatetime.UDateTime(-10 ** 18)
+
+        for days in (213503982, timedelta.max.days, 3652059):
+            with self.assertRaises(OverflowError):
+                u + timedelta(days=days)
+
+            with self.assertRaises(OverflowError):
+                u - timedelta(days=days)
+
+    def test_http_date(self):
+        http_date = 'Sun, 06 Nov 1994 08:49:37 GMT'
+        dt = udatetime.from_string('1994-11-06T09:49:37.123456+01:00')
+
+        self.assertEqual(udatetime.to_http_date(dt), http_date)
+        self.assertEqual(udatetime.to_http_date(784111777.9), http_date)
+        self.assertEqual(udatetime.to_http_date(784111777), http_date)
+        self.assertEqual(
+            udatetime.to_http_date(
+                udatetime.from_string(udatetime.to_string(dt), compact=True)
+            ),
+            http_date
+        )
+        self.assertEqual(
+            udatetime.to_http_date(-62135596800),
+            'Mon, 01 Jan 0001 00:00:00 GMT'
+        )
+
+        now = udatetime.utcnow_to_http_date()
+        self.assertEqual(len(now), 29)
+        self.assertTrue(now.endswith(' GMT'))
+        self.assertEqual(udatetime.from_http_date(now).tzinfo.offset, 0)
+
+        expected = datetime(
+            1994, 11, 6, 8, 49, 37, tzinfo=udatetime.TZFixedOffset(0)
+        )
+        for s in (http_date, 'Sunday, 06-Nov-94 08:49:37 GMT',
+                  'Sun Nov  6 08:49:37 1994', 'sun, 06 nov 1994 08:49:37 UT',
+                  'Sun, 06 Nov 1994 09:19:37 +0030'):
+            self.assertEqual(udatetime.from_http_date(s), expected)
+
+        dt = udatetime.from_http_date('Sun, 06 Nov 1994 09:19:37 +0030')
+        self.assertEqual(dt.utcoffset(), timedelta(minutes=30))
+        self.assertEqual(
+            udatetime.from_http_date('Sun, 06 Nov 1994 23:59:60 GMT').second,
+            59
+        )
+
+        for s in ('Tue, 29 Feb 1994 08:49:37 GMT',
+                  'Sun, 06 Nov 1994 24:49:37 GMT',
+                  'Sun, 06 Nov 1994 08:49:37 EST',
+                  'Sun, 06 Nov 1994 08:49:37 GMT trailing',
+                  'Sun, 06 Foo 1994 08:49:37 GMT',
+                  'Sun, 06 Nov 1994 08:49:37',
+                  'Sun, 06 Nov 94 08:49:37 GMT',
+                  'Sun, 06 Nov 994 08:49:37 GMT',
+                  'Sun, 06 Nov +994 08:49:37 GMT',
+                  'Sun Nov  6 08:49:37 94',
+                  'Sun Nov  6 08:49:37 +994',
+                  ' Sun, 06 Nov 1994 08:49:37 GMT',
+                  ' Sunday, 06-Nov-94 08:49:37 GMT',
+                  ' Sun Nov  6 08:49:37 1994', ''):
+            with self.assertRaises(ValueError):
+                udatetime.from_http_date(s)
+
+        with self.assertRaises(ValueError):
+            udatetime.to_http_date(1e18)
+
+    def test_diff(self):
+        start = '2016-07-18T10:58:26Z'
+        end = '2016-07-18T12:58:26.500000+02:00'
+
+        self.assertEqual(udatetime.diff_us(end, start), 500000)
+        self.assertEqual(udatetime.diff_us(start, end), -500000)
+        self.assertEqual(
+            udatetime.diff_us('0001-01-01T00:00:00Z', '9999-12-31T23:59:59Z'),
+            -315537897599000000
+        )
+
+        with self.assertRaises(ValueError):
+            udatetime.diff_us(end, '2016-02-30T10:58:26Z')
+
+        ends = [end, '2016-07-19T00:00:00-00:30', '1970-01-01T00:00:00Z']
+        starts = [start, '2016-07-18T23:59:59.999999Z', end]
+        out = int64_buffer([0] * 3)
+
+        self.assertIsNone(udatetime.diff_many(ends, starts, out))
+        self.assertEqual(int64_values(out), [
+            udatetime.diff_us(a, b) for a, b in zip(ends, starts)
+        ])
+        self.assertEqual(int64_values(out)[1], 1800000001)
+
+        with self.assertRaises(ValueError):
+            udatetime.diff_many(ends, starts[:2], out)
+
+        with self.assertRaises(ValueError):
+            udatetime.diff_many(ends, starts, int64_buffer([0] * 2))
+
+        with self.assertRaises(ValueError):
+            udatetime.diff_many([end, 'Hello World'], [start, start], out)
+
+        with self.assertRaises(TypeError):
+            udatetime.diff_many([end], [None], out)
+
+        with self.assertRaises(TypeError):
+            udatetime.diff_many([end], [start], array('d', [0]))
 
 
 if __name__ == '__main__':
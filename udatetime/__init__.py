@@ -9,11 +9,40 @@ if __pypy__:
         utcnow,
         now,
         from_rfc3339_string as from_string,
+        from_rfc3339_string_tuple as from_string_tuple,
+        rfc3339_strings_to_components as strings_to_components,
         to_rfc3339_string as to_string,
+        encode_datetimes,
+        json_default,
+        to_bytes,
+        from_bytes,
+        to_bytes_many,
+        from_bytes_many,
         utcnow_to_string,
         now_to_string,
+        to_http_date,
+        from_http_date,
+        utcnow_to_http_date,
         from_timestamp as fromtimestamp,
         from_utctimestamp as utcfromtimestamp,
+        to_timestamp,
+        rfc3339_string_to_timestamp as string_to_timestamp,
+        rfc3339_string_to_timestamp_us as string_to_timestamp_us,
+        floor_timestamps_us,
+        timestamps_to_rfc3339_strings as timestamps_to_strings,
+        normalize_many,
+        is_valid,
+        validate_many,
+        diff_us,
+        diff_many,
+        enable_coarse_clock,
+        disable_coarse_clock,
+        stats,
+        reset_stats,
+        enable_string_cache,
+        disable_string_cache,
+        StringCache,
+        UDateTime,
         TZFixedOffset
     )
 else:
@@ -21,15 +50,54 @@ else:
         utcnow,
         now,
         from_rfc3339_string as from_string,
+        from_rfc3339_string_tuple as from_string_tuple,
+        rfc3339_strings_to_components as strings_to_components,
         to_rfc3339_string as to_string,
+        encode_datetimes,
+        json_default,
+        to_bytes,
+        from_bytes,
+        to_bytes_many,
+        from_bytes_many,
         utcnow_to_string,
         now_to_string,
+        to_http_date,
+        from_http_date,
+        utcnow_to_http_date,
         from_timestamp as fromtimestamp,
         from_utctimestamp as utcfromtimestamp,
+        to_timestamp,
+        rfc3339_string_to_timestamp as string_to_timestamp,
+        rfc3339_string_to_timestamp_us as string_to_timestamp_us,
+        floor_timestamps_us,
+        timestamps_to_rfc3339_strings as timestamps_to_strings,
+        normalize_many,
+        is_valid,
+        validate_many,
+        diff_us,
+        diff_many,
+        enable_coarse_clock,
+        disable_coarse_clock,
+        stats,
+        reset_stats,
+        enable_string_cache,
+        disable_string_cache,
+        StringCache,
+        UDateTime,
         TZFixedOffset
     )
 
 __all__ = [
-    'utcnow', 'now', 'from_string', 'to_string', 'utcnow_to_string',
-    'now_to_string', 'fromtimestamp', 'utcfromtimestamp', 'TZFixedOffset'
+    'utcnow', 'now', 'from_string', 'from_string_tuple',
+    'strings_to_components', 'to_string',
+    'encode_datetimes', 'json_default', 'to_bytes', 'from_bytes',
+    'to_bytes_many', 'from_bytes_many', 'utcnow_to_string',
+    'now_to_string', 'to_http_date', 'from_http_date',
+    'utcnow_to_http_date', 'fromtimestamp', 'utcfromtimestamp', 'to_timestamp',
+    'string_to_timestamp', 'string_to_timestamp_us', 'floor_timestamps_us',
+    'timestamps_to_strings',
+    'normalize_many', 'is_valid', 'validate_many', 'diff_us', 'diff_many',
+    'enable_coarse_clock',
+    'disable_coarse_clock', 'stats', 'reset_stats', 'enable_string_cache',
+    'disable_string_cache', 'StringCache', 'UDateTime', 'TZFixedOffset'
 ]
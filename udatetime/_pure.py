@@ -1,8 +1,50 @@
-from datetime import tzinfo, timedelta, datetime as dt_datetime
+from datetime import tzinfo, timedelta, datetime as dt_datetime, date as dt_date
 from time import time, gmtime
 from math import floor, ceil
+from collections import namedtuple
+from struct import Struct
+import re
 
 DATE_TIME_FORMAT = '%Y-%m-%dT%H:%M:%S.%f'
+EPOCH = dt_datetime(1970, 1, 1)
+
+PACKED_DATE_TIME = Struct('<qh')
+
+# 0001-01-01T00:00:00Z - 1 day, 9999-12-31T23:59:59Z + 1 day
+MIN_TIMESTAMP_US = -62135683200 * 1000000
+MAX_TIMESTAMP_US = 253402387199 * 1000000
+
+BUCKET_UNITS = ('second', 'minute', 'hour', 'day', 'week', 'month', 'year')
+
+HTTP_WDAYS = ('Mon', 'Tue', 'Wed', 'Thu', 'Fri', 'Sat', 'Sun')
+HTTP_WDAYS_LONG = (
+    'Monday', 'Tuesday', 'Wednesday', 'Thursday', 'Friday', 'Saturday',
+    'Sunday'
+)
+HTTP_MONTHS = (
+    'Jan', 'Feb', 'Mar', 'Apr', 'May', 'Jun',
+    'Jul', 'Aug', 'Sep', 'Oct', 'Nov', 'Dec'
+)
+
+# IMF-fixdate (RFC 2822 zones), rfc850-date and asctime-date
+HTTP_DATE_IMF = re.compile(
+    r'([A-Za-z]{3}),\s*(\d{1,2})\s*([A-Za-z]{3})\s*(\d{4})'
+    r'\s*(\d{1,2}):(\d{1,2}):(\d{1,2})\s*(\S{1,5}) *$'
+)
+HTTP_DATE_RFC850 = re.compile(
+    r'([A-Za-z]{4,9}),\s*(\d{1,2})-([A-Za-z]{3})-(\d{1,2})'
+    r'\s*(\d{1,2}):(\d{1,2}):(\d{1,2})\s*(\S{1,5}) *$'
+)
+HTTP_DATE_ASCTIME = re.compile(
+    r'([A-Za-z]{3})\s*([A-Za-z]{3})\s*(\d{1,2})'
+    r'\s*(\d{1,2}):(\d{1,2}):(\d{1,2})\s*(\d{4}) *$'
+)
+HTTP_DATE_ZONE = re.compile(r'([+-])(\d\d)(\d\d)$')
+
+DateTimeTuple = namedtuple(
+    'DateTimeTuple',
+    'year month day hour minute second usec offset wday'
+)
 
 
 class TZFixedOffset(tzinfo):
@@ -63,6 +105,95 @@ def _format_date_time(date_time):
     )
 
 
+def _date_time_to_timestamp_us(date_time):
+    offset = 0
+
+    if date_time.tzinfo is not None:
+        if date_time.tzinfo.__class__ is not TZFixedOffset:
+            # TODO: Support all tzinfo subclasses by calling utcoffset()
+            raise ValueError('Only TZFixedOffset supported.')
+        offset = date_time.tzinfo.offset
+
+    delta = date_time.replace(tzinfo=None) - EPOCH
+    secs = (delta.days * 86400) + delta.seconds - (offset * 60)
+    return (secs * 1000000) + delta.microseconds
+
+
+def _int64_view(obj):
+    view = memoryview(obj)
+
+    format = view.format.lstrip('@=')
+
+    if not (view.itemsize == 8 and format in ('q', 'l')) and\
+            not (view.itemsize == 1 and format in ('B', 'b', 'c') and
+                 view.nbytes % 8 == 0):
+        raise TypeError('Expected a buffer of int64 items.')
+
+    return view.cast('B').cast('q')
+
+
+def _days_from_civil(year, month, day):
+    year -= month <= 2
+    era = year // 400
+    yoe = year - era * 400
+    doy = (153 * (month - 3 if month > 2 else month + 9) + 2) // 5 + day - 1
+    doe = yoe * 365 + yoe // 4 - yoe // 100 + doy
+    return era * 146097 + doe - 719468
+
+
+def _civil_from_days(days):
+    days += 719468
+    era = days // 146097
+    doe = days - era * 146097
+    yoe = (doe - doe // 1460 + doe // 36524 - doe // 146096) // 365
+    doy = doe - (365 * yoe + yoe // 4 - yoe // 100)
+    mp = (5 * doy + 2) // 153
+    day = doy - (153 * mp + 2) // 5 + 1
+    month = mp + 3 if mp < 10 else mp - 9
+    return (yoe + era * 400 + (month <= 2), month, day)
+
+
+def _floor_timestamp_us(timestamp_us, unit, offset):
+    offset_us = offset * 60 * 1000000
+    local_us = timestamp_us + offset_us
+
+    if unit == 'second':
+        local_us -= local_us % 1000000
+    elif unit == 'minute':
+        local_us -= local_us % 60000000
+    elif unit == 'hour':
+        local_us -= local_us % 3600000000
+    elif unit == 'day':
+        local_us -= local_us % 86400000000
+    else:
+        days = local_us // 86400000000
+
+        if unit == 'week':
+            # 1970-01-01 was a Thursday, 3 days after Monday
+            days -= (days + 3) % 7
+        else:
+            year, month, _ = _civil_from_days(days)
+            days = _days_from_civil(year, 1 if unit == 'year' else month, 1)
+
+        local_us = days * 86400000000
+
+    return local_us - offset_us
+
+
+def _format_date_time_utc(date_time, precision):
+    date_time = (date_time - date_time.utcoffset()).replace(tzinfo=None)
+    datetime_string = '%04d-%02d-%02dT%02d:%02d:%02d' % (
+        date_time.year, date_time.month, date_time.day, date_time.hour,
+        date_time.minute, date_time.second
+    )
+
+    if precision > 0:
+        datetime_string += '.%06d' % date_time.microsecond
+        datetime_string = datetime_string[:precision - 6 or None]
+
+    return datetime_string + 'Z'
+
+
 def _get_local_utc_offset():
     ts = time()
     return (
@@ -84,9 +215,176 @@ def now():
     return _timestamp_to_date_time(time(), local_timezone)
 
 
-def from_rfc3339_string(rfc3339_string):
+class StringCache(object):
+    '''Bounded cache of parsed RFC3339 strings.'''
+
+    def __init__(self, size=1024):
+        if size < 1 or size > (1 << 24):
+            raise ValueError('size must be 1 - 16777216.')
+
+        slots = 1
+        while slots < size:
+            slots <<= 1
+
+        self._mask = slots - 1
+        self._entries = [None] * slots
+        self.hits = 0
+        self.misses = 0
+
+    def from_string(self, rfc3339_string):
+        '''Parse RFC3339 compliant date-time string, cached.'''
+        index = hash(rfc3339_string) & self._mask
+        entry = self._entries[index]
+
+        if entry is not None and entry[0] == rfc3339_string:
+            self.hits += 1
+            return entry[1]
+
+        self.misses += 1
+        value = _parse_rfc3339_string(rfc3339_string)
+        self._entries[index] = (rfc3339_string, value)
+        return value
+
+    def clear(self):
+        '''Drop all cached entries and reset hits and misses.'''
+        self._entries = [None] * (self._mask + 1)
+        self.hits = 0
+        self.misses = 0
+
+
+string_cache = None
+
+
+def enable_string_cache(size=1024):
+    '''[size] -> cache from_string() results, returns the StringCache.'''
+    global string_cache
+    string_cache = StringCache(size)
+    return string_cache
+
+
+def disable_string_cache():
+    '''Stop caching from_string() results.'''
+    global string_cache
+    string_cache = None
+
+
+class UDateTime(object):
+    '''Compact date-time, usec since epoch and UTC offset in minutes.'''
+
+    __slots__ = ('timestamp_us', 'offset')
+
+    def __init__(self, timestamp_us, offset=0):
+        if offset <= -24 * 60 or offset >= 24 * 60:
+            raise OverflowError('date value out of range')
+
+        try:
+            EPOCH + timedelta(minutes=offset, microseconds=timestamp_us)
+        except OverflowError:
+            raise OverflowError('date value out of range')
+
+        self.timestamp_us = timestamp_us
+        self.offset = offset
+
+    @classmethod
+    def from_datetime(cls, date_time):
+        offset = 0 if date_time.tzinfo is None else date_time.tzinfo.offset
+        return cls(_date_time_to_timestamp_us(date_time), offset)
+
+    def to_string(self):
+        '''RFC3339 compliant date-time string.'''
+        return _format_date_time(self.to_datetime())
+
+    def timestamp(self):
+        '''POSIX timestamp.'''
+        return self.timestamp_us / 1e6
+
+    def to_datetime(self):
+        '''datetime aware object with TZFixedOffset.'''
+        return (EPOCH + timedelta(
+            minutes=self.offset, microseconds=self.timestamp_us
+        )).replace(tzinfo=TZFixedOffset(self.offset))
+
+    def __reduce__(self):
+        return (UDateTime, (self.timestamp_us, self.offset))
+
+    def __repr__(self):
+        return "UDateTime('%s')" % self.to_string()
+
+    __str__ = to_string
+
+    def __eq__(self, other):
+        if other.__class__ is not UDateTime:
+            return NotImplemented
+        return self.timestamp_us == other.timestamp_us
+
+    def __ne__(self, other):
+        if other.__class__ is not UDateTime:
+            return NotImplemented
+        return self.timestamp_us != other.timestamp_us
+
+    def __lt__(self, other):
+        if other.__class__ is not UDateTime:
+            return NotImplemented
+        return self.timestamp_us < other.timestamp_us
+
+    def __le__(self, other):
+        if other.__class__ is not UDateTime:
+            return NotImplemented
+        return self.timestamp_us <= other.timestamp_us
+
+    def __gt__(self, other):
+        if other.__class__ is not UDateTime:
+            return NotImplemented
+        return self.timestamp_us > other.timestamp_us
+
+    def __ge__(self, other):
+        if other.__class__ is not UDateTime:
+            return NotImplemented
+        return self.timestamp_us >= other.timestamp_us
+
+    def __hash__(self):
+        return hash(self.timestamp_us)
+
+    def __add__(self, other):
+        if not isinstance(other, timedelta):
+            return NotImplemented
+        return UDateTime(
+            self.timestamp_us + _timedelta_to_us(other), self.offset
+        )
+
+    __radd__ = __add__
+
+    def __sub__(self, other):
+        if other.__class__ is UDateTime:
+            return timedelta(
+                microseconds=self.timestamp_us - other.timestamp_us
+            )
+        elif isinstance(other, timedelta):
+            return UDateTime(
+                self.timestamp_us - _timedelta_to_us(other), self.offset
+            )
+
+        return NotImplemented
+
+
+def _timedelta_to_us(delta):
+    return (
+        (delta.days * 86400 + delta.seconds) * 1000000 + delta.microseconds
+    )
+
+
+def from_rfc3339_string(rfc3339_string, compact=False):
     '''Parse RFC3339 compliant date-time string.'''
+    if compact:
+        return UDateTime.from_datetime(_parse_rfc3339_string(rfc3339_string))
+
+    if string_cache is not None:
+        return string_cache.from_string(rfc3339_string)
+
+    return _parse_rfc3339_string(rfc3339_string)
 
+
+def _parse_rfc3339_string(rfc3339_string):
     rfc3339_string = rfc3339_string.replace(' ', '').lower()
 
     if 't' not in rfc3339_string:
@@ -182,8 +480,21 @@ def from_rfc3339_string(rfc3339_string):
     )
 
 
+def from_rfc3339_string_tuple(rfc3339_string):
+    '''Parse RFC3339 date-time string to DateTimeTuple.'''
+    date_time = from_rfc3339_string(rfc3339_string)
+
+    return DateTimeTuple(
+        date_time.year, date_time.month, date_time.day, date_time.hour,
+        date_time.minute, date_time.second, date_time.microsecond,
+        date_time.tzinfo.offset, (date_time.isoweekday() % 7) + 1
+    )
+
+
 def to_rfc3339_string(date_time):
     '''Serialize date_time to RFC3339 compliant date-time string.'''
+    if date_time.__class__ is UDateTime:
+        date_time = date_time.to_datetime()
 
     if date_time and date_time.__class__ is not dt_datetime:
         raise ValueError("Expected a datetime object.")
@@ -191,14 +502,118 @@ def to_rfc3339_string(date_time):
     return _format_date_time(date_time)
 
 
-def from_timestamp(timestamp, tz=None):
-    '''timestamp[, tz] -> tz's local time from POSIX timestamp.'''
+def to_timestamp(date_time):
+    '''datetime -> POSIX timestamp, without timegm() or mktime().'''
+    if date_time.__class__ is UDateTime:
+        date_time = date_time.to_datetime()
+
+    if date_time.__class__ is not dt_datetime:
+        raise ValueError("Expected a datetime object.")
+
+    return _date_time_to_timestamp_us(date_time) / 1e6
+
+
+def rfc3339_string_to_timestamp(rfc3339_string):
+    '''Parse RFC3339 date-time string to POSIX timestamp.'''
+    return _date_time_to_timestamp_us(
+        from_rfc3339_string(rfc3339_string)
+    ) / 1e6
+
+
+def rfc3339_string_to_timestamp_us(rfc3339_string):
+    '''Parse RFC3339 date-time string to int microseconds since epoch.'''
+    return _date_time_to_timestamp_us(from_rfc3339_string(rfc3339_string))
+
+
+def encode_datetimes(obj, dates=False):
+    '''obj[, dates] -> copy with datetime (and date) as RFC3339 strings.'''
+    if isinstance(obj, dict):
+        return dict((k, encode_datetimes(v, dates)) for k, v in obj.items())
+    elif isinstance(obj, list):
+        return [encode_datetimes(v, dates) for v in obj]
+    elif isinstance(obj, tuple):
+        return tuple(encode_datetimes(v, dates) for v in obj)
+    elif isinstance(obj, dt_datetime):
+        return _format_date_time(obj)
+    elif obj.__class__ is UDateTime:
+        return obj.to_string()
+    elif dates and isinstance(obj, dt_date):
+        return '%04d-%02d-%02d' % (obj.year, obj.month, obj.day)
+
+    return obj
+
+
+def json_default(obj):
+    '''json.dumps() default hook, datetime and date to RFC3339 strings.'''
+    if isinstance(obj, dt_date) or obj.__class__ is UDateTime:
+        return encode_datetimes(obj, True)
+
+    raise TypeError(
+        'Object of type %s is not JSON serializable' % type(obj).__name__
+    )
+
+
+def to_bytes(date_time):
+    '''datetime -> 10 bytes, int64 usec since epoch and int16 offset.'''
+    if date_time.__class__ is UDateTime:
+        date_time = date_time.to_datetime()
+    if date_time.__class__ is not dt_datetime:
+        raise ValueError("Expected a datetime object.")
+
+    offset = 0 if date_time.tzinfo is None else date_time.tzinfo.offset
+    return PACKED_DATE_TIME.pack(
+        _date_time_to_timestamp_us(date_time), offset
+    )
+
+
+def from_bytes(packed):
+    '''10 bytes packed by to_bytes() -> datetime.'''
+    if len(packed) != PACKED_DATE_TIME.size:
+        raise ValueError('Expected %d bytes.' % PACKED_DATE_TIME.size)
+
+    (timestamp_us, offset) = PACKED_DATE_TIME.unpack(packed)
+
+    if offset <= -24 * 60 or offset >= 24 * 60:
+        raise ValueError('Invalid packed date-time. Offset out of range.')
+
+    try:
+        date_time = EPOCH + timedelta(
+            minutes=offset, microseconds=timestamp_us
+        )
+    except OverflowError:
+        raise ValueError('Invalid packed date-time. Timestamp out of range.')
+
+    return date_time.replace(tzinfo=TZFixedOffset(offset))
+
+
+def to_bytes_many(date_times):
+    '''sequence of datetime -> concatenated to_bytes() output.'''
+    return b''.join([to_bytes(date_time) for date_time in date_times])
+
+
+def from_bytes_many(packed):
+    '''Bytes packed by to_bytes_many() -> list of datetime.'''
+    size = PACKED_DATE_TIME.size
+
+    if len(packed) % size:
+        raise ValueError('Expected a multiple of %d bytes.' % size)
+
+    return [
+        from_bytes(packed[i:i + size]) for i in range(0, len(packed), size)
+    ]
+
+
+def from_timestamp(timestamp, tz=None, compact=False):
+    '''timestamp[, tz, compact] -> tz's local time from POSIX timestamp.'''
     if tz is None:
         tz = local_timezone
     elif tz.__class__ is not TZFixedOffset:
         # TODO: Support all tzinfo subclasses by calling utcoffset()
         raise ValueError('Only TZFixedOffset supported.')
 
+    if compact:
+        return UDateTime.from_datetime(_timestamp_to_date_time(timestamp, tz))
+
     return _timestamp_to_date_time(timestamp, tz)
 
 
@@ -207,6 +622,194 @@ def from_utctimestamp(timestamp):
     return _timestamp_to_date_time(timestamp, utc_timezone)
 
 
+def floor_timestamps_us(values, out, unit, offset=0):
+    '''values, out, unit[, offset] -> write bucket starts to out.'''
+    if unit not in BUCKET_UNITS:
+        raise ValueError("Invalid unit '%s'." % unit)
+
+    if offset <= -24 * 60 or offset >= 24 * 60:
+        raise ValueError('offset must be -1439 - 1439.')
+
+    values = _int64_view(values)
+    out = _int64_view(out)
+
+    if len(out) < len(values):
+        raise ValueError('out is smaller than values.')
+
+    for i in range(len(values)):
+        if values[i] < MIN_TIMESTAMP_US or values[i] > MAX_TIMESTAMP_US:
+            raise OverflowError('timestamp out of range at index %d.' % i)
+
+        out[i] = _floor_timestamp_us(values[i], unit, offset)
+
+
+def normalize_many(strings, precision=6):
+    '''strings[, precision] -> list of RFC3339 strings converted to UTC.'''
+    if precision < 0 or precision > 6:
+        raise ValueError('precision must be 0 - 6.')
+
+    try:
+        return [
+            _format_date_time_utc(from_rfc3339_string(s), precision)
+            for s in strings
+        ]
+    except OverflowError:
+        raise ValueError('date-time out of range in UTC.')
+
+
+def is_valid(rfc3339_string):
+    '''True if string is a valid RFC3339 date-time string.'''
+    try:
+        from_rfc3339_string(rfc3339_string)
+    except ValueError:
+        return False
+
+    return True
+
+
+def validate_many(strings, out=None):
+    '''strings[, out] -> one byte per string, 1 if valid else 0.'''
+    strings = list(strings)
+
+    if out is None:
+        out = bytearray(len(strings))
+
+    view = memoryview(out).cast('B')
+
+    if len(view) < len(strings):
+        raise ValueError('out is smaller than strings.')
+
+    for i, s in enumerate(strings):
+        view[i] = isinstance(s, str) and '\x00' not in s and is_valid(s)
+
+    return out
+
+
+def diff_us(a, b):
+    '''a, b -> signed microseconds a - b of two RFC3339 date-time strings.'''
+    return _date_time_to_timestamp_us(_parse_rfc3339_string(a)) -\
+        _date_time_to_timestamp_us(_parse_rfc3339_string(b))
+
+
+def _parse_sequence_item(strings, i):
+    if not isinstance(strings[i], str):
+        raise TypeError('Expected a string at index %d.' % i)
+
+    try:
+        if '\x00' in strings[i]:
+            raise ValueError()
+        return _parse_rfc3339_string(strings[i])
+    except ValueError:
+        raise ValueError(
+            'Invalid RFC3339 date-time string at index %d.' % i
+        )
+
+
+def diff_many(a_strings, b_strings, out):
+    '''a_strings, b_strings, out -> out[i] = diff_us(a[i], b[i]).'''
+    a_strings = list(a_strings)
+    b_strings = list(b_strings)
+
+    if len(a_strings) != len(b_strings):
+        raise ValueError('a_strings and b_strings differ in length.')
+
+    out = _int64_view(out)
+
+    if len(out) < len(a_strings):
+        raise ValueError('out is smaller than a_strings.')
+
+    for i in range(len(a_strings)):
+        a = _parse_sequence_item(a_strings, i)
+        b = _parse_sequence_item(b_strings, i)
+        out[i] = _date_time_to_timestamp_us(a) -\
+            _date_time_to_timestamp_us(b)
+
+
+def enable_coarse_clock(resolution=0.001):
+    '''No-op in pure Python, the clock is always read per call.'''
+    if not (1e-9 <= resolution <= 60.0):
+        raise ValueError('resolution must be >= 1 ns and <= 60 seconds.')
+
+
+def disable_coarse_clock():
+    '''No-op in pure Python, the clock is always read per call.'''
+
+
+def timestamps_to_rfc3339_strings(values, offset=0, unit='us', packed=False):
+    '''values[, offset, unit, packed] -> RFC3339 strings of int64 buffer.'''
+    if unit not in ('us', 'ns'):
+        raise ValueError("unit must be 'us' or 'ns'.")
+
+    if offset <= -24 * 60 or offset >= 24 * 60:
+        raise ValueError('offset must be within +/-23:59.')
+
+    tz = TZFixedOffset(offset)
+    strings = []
+
+    for i, value in enumerate(_int64_view(values)):
+        if unit == 'ns':
+            value //= 1000
+
+        try:
+            date_time = EPOCH + timedelta(minutes=offset, microseconds=value)
+        except OverflowError:
+            raise ValueError(
+                'timestamp at index %d out of range for RFC3339.' % i
+            )
+
+        strings.append(_format_date_time(date_time.replace(tzinfo=tz)))
+
+    if packed:
+        return ''.join(strings).encode('ascii')
+
+    return strings
+
+
+def stats():
+    '''Hot path counters, not available in pure Python.'''
+    return {}
+
+
+def reset_stats():
+    '''Reset the stats() counters, no-op in pure Python.'''
+
+
+def rfc3339_strings_to_components(strings, year=None, month=None, day=None,
+                                  hour=None, minute=None, second=None,
+                                  usec=None, offset=None, wday=None):
+    '''strings[, year, ..., wday] -> write components to int buffers.'''
+    strings = list(strings)
+    columns = []
+
+    for (index, name) in enumerate(DateTimeTuple._fields):
+        column = locals()[name]
+
+        if column is None:
+            continue
+
+        view = memoryview(column)
+        format = view.format.lstrip('@=')
+
+        if view.readonly or view.itemsize not in (4, 8) or\
+                format not in ('i', 'l', 'q'):
+            raise TypeError('Expected a buffer of int32 or int64 items.')
+
+        view = view.cast('B').cast('i' if view.itemsize == 4 else 'q')
+
+        if len(view) < len(strings):
+            raise ValueError('%s is smaller than strings.' % name)
+
+        columns.append((index, view))
+
+    for (i, rfc3339_string) in enumerate(strings):
+        components = from_rfc3339_string_tuple(rfc3339_string)
+
+        for (index, view) in columns:
+            view[i] = components[index]
+
+    return len(strings)
+
+
 def utcnow_to_string():
     '''Current UTC date and time RFC3339 compliant date-time string.'''
     return _format_date_time(utcnow())
@@ -215,3 +818,102 @@ def utcnow_to_string():
 def now_to_string():
     '''Local date and time RFC3339 compliant date-time string.'''
     return _format_date_time(now())
+
+
+def _format_http_date(timestamp_us):
+    date_time = EPOCH + timedelta(microseconds=timestamp_us)
+
+    return '%s, %02d %s %04d %02d:%02d:%02d GMT' % (
+        HTTP_WDAYS[date_time.weekday()], date_time.day,
+        HTTP_MONTHS[date_time.month - 1], date_time.year, date_time.hour,
+        date_time.minute, date_time.second
+    )
+
+
+def to_http_date(value):
+    '''datetime, UDateTime or POSIX timestamp -> HTTP-date string.'''
+    if value.__class__ is UDateTime:
+        timestamp_us = value.timestamp_us
+    elif isinstance(value, dt_datetime):
+        timestamp_us = _date_time_to_timestamp_us(value)
+    else:
+        timestamp_us = int(floor(float(value))) * 1000000
+
+    timestamp_us -= timestamp_us % 1000000
+
+    try:
+        return _format_http_date(timestamp_us)
+    except OverflowError:
+        raise ValueError('date value out of range')
+
+
+_http_date_cache = [None, None]
+
+
+def utcnow_to_http_date():
+    '''Current time HTTP-date string, cached per second.'''
+    secs = int(floor(time()))
+
+    if _http_date_cache[0] != secs:
+        _http_date_cache[1] = _format_http_date(secs * 1000000)
+        _http_date_cache[0] = secs
+
+    return _http_date_cache[1]
+
+
+def from_http_date(http_date_string):
+    '''Parse HTTP-date string (IMF-fixdate, RFC 850 or asctime).'''
+    match = HTTP_DATE_IMF.match(http_date_string)
+
+    if match:
+        wday, day, month, year, hour, minute, second, zone = match.groups()
+    else:
+        match = HTTP_DATE_RFC850.match(http_date_string)
+
+        if match:
+            wday, day, month, year, hour, minute, second, zone =\
+                match.groups()
+            year = int(year) + (2000 if int(year) < 50 else 1900)
+        else:
+            match = HTTP_DATE_ASCTIME.match(http_date_string)
+
+            if not match:
+                raise ValueError('Invalid HTTP-date string. Date invalid.')
+
+            wday, month, day, hour, minute, second, year = match.groups()
+            zone = 'GMT'
+
+    wday = wday.capitalize()
+    month = month.capitalize()
+
+    if wday not in HTTP_WDAYS and wday not in HTTP_WDAYS_LONG or\
+            month not in HTTP_MONTHS:
+        raise ValueError('Invalid HTTP-date string. Date invalid.')
+
+    try:
+        date = dt_date(int(year), HTTP_MONTHS.index(month) + 1, int(day))
+    except ValueError:
+        raise ValueError('Invalid HTTP-date string. Date invalid.')
+
+    hour, minute, second = int(hour), int(minute), int(second)
+
+    if hour > 23 or minute > 59 or second > 60:
+        raise ValueError('Invalid HTTP-date string. Time invalid.')
+
+    if zone.upper() in ('GMT', 'UT', 'UTC', 'Z'):
+        offset = 0
+    else:
+        match = HTTP_DATE_ZONE.match(zone)
+
+        if not match or int(match.group(2)) > 23 or\
+                int(match.group(3)) > 59:
+            raise ValueError('Invalid HTTP-date string. Time invalid.')
+
+        offset = int(match.group(2)) * 60 + int(match.group(3))
+        if match.group(1) == '-':
+            offset = -offset
+
+    return dt_datetime(
+        date.year, date.month, date.day, hour, minute, min(second, 59), 0,
+        TZFixedOffset(offset)
+    )